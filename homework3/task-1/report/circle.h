@@ -0,0 +1,20 @@
+#ifndef CIRCLE_H
+#define CIRCLE_H
+
+#include <cmath>
+#include <iostream>
+
+class circle {
+public:
+    double x, y, r;
+    
+    void input() {
+        std::cin >> x >> y >> r;
+    }
+    
+     bool dotInside(double a, double b) const {
+        return (std::sqrt((x - a) * (x - a) + (y - b) * (y - b)) <= r);
+    }
+};
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef CIRCLE_AREA_H
+#define CIRCLE_AREA_H
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "circle.h"
+
+// Точная площадь объединения и пересечения n кругов за O(n^2 log n).
+// Граница фигуры состоит из дуг окружностей. Для каждой окружности считаем,
+// какие ее дуги покрыты другими кругами (угловые интервалы), и сканируем их:
+//  - объединение: граница - дуги, не покрытые ни одним другим кругом;
+//  - пересечение: граница - дуги, лежащие внутри всех остальных кругов.
+// Площадь по формуле Грина: S = 1/2 * сумма по дугам интеграла (x dy - y dx),
+// дуги обходятся против часовой стрелки (для дыр объединения это дает вычитание).
+// Совпадающие круги учитываются один раз, касания обрабатываются с допуском.
+class CircleArea {
+public:
+    // Круги отсортированы по x: кандидаты для круга i лежат в окне |x_j - x_i| < r_i + r_max,
+    // его границы находятся бинарным поиском. В худшем случае это все те же n^2 пар,
+    // но для разреженных наборов остаются только соседи
+    static double unionArea(const std::vector<circle>& input) {
+        std::vector<circle> circles = unique(input);
+        std::sort(circles.begin(), circles.end(),
+                  [](const circle& a, const circle& b) { return a.x < b.x; });
+        double max_r = 0;
+        for (const circle& c : circles) max_r = std::max(max_r, c.r);
+
+        double area = 0;
+        for (size_t i = 0; i < circles.size(); i++) {
+            std::vector<Event> events;
+            bool covered = false;
+            double reach = circles[i].r + max_r;
+            size_t first = std::lower_bound(circles.begin(), circles.end(), circles[i].x - reach,
+                                            [](const circle& c, double x) { return c.x < x; }) - circles.begin();
+            for (size_t j = first; j < circles.size() && circles[j].x <= circles[i].x + reach && !covered; j++) {
+                if (i == j) continue;
+                switch (relate(circles[i], circles[j])) {
+                    case INSIDE:
+                        covered = true; // Вся окружность i внутри круга j
+                        break;
+                    case OVERLAP:
+                        addArc(circles[i], circles[j], events);
+                        break;
+                    default:
+                        break; // Не пересекаются или j внутри i - дугам i не мешает
+                }
+            }
+            if (!covered) {
+                area += sweep(circles[i], events, [](int count) { return count == 0; });
+            }
+        }
+        return area;
+    }
+
+    static double intersectionArea(const std::vector<circle>& input) {
+        std::vector<circle> circles = unique(input);
+        double area = 0;
+        for (size_t i = 0; i < circles.size(); i++) {
+            std::vector<Event> events;
+            int constraints = 0;
+            bool excluded = false;
+            for (size_t j = 0; j < circles.size() && !excluded; j++) {
+                if (i == j) continue;
+                switch (relate(circles[i], circles[j])) {
+                    case DISJOINT:
+                        return 0; // Два круга без общей площади
+                    case CONTAINS:
+                        excluded = true; // Окружность i целиком вне круга j
+                        break;
+                    case OVERLAP:
+                        addArc(circles[i], circles[j], events);
+                        constraints++;
+                        break;
+                    default:
+                        break; // i внутри j - ограничений на дуги i нет
+                }
+            }
+            if (!excluded) {
+                area += sweep(circles[i], events, [constraints](int count) { return count == constraints; });
+            }
+        }
+        return area;
+    }
+
+private:
+    // Положение круга a относительно круга b
+    enum Relation {
+        DISJOINT, // Не пересекаются (или касаются снаружи)
+        INSIDE,   // a внутри b (возможно, с касанием изнутри)
+        CONTAINS, // b внутри a
+        OVERLAP   // Границы пересекаются в двух точках
+    };
+
+    struct Event {
+        double angle;
+        int delta;
+
+        bool operator<(const Event& other) const { return angle < other.angle; }
+    };
+
+    static double tolerance(const circle& a, const circle& b) {
+        return 1e-12 * std::max({a.r, b.r, std::abs(a.x), std::abs(a.y), std::abs(b.x), std::abs(b.y), 1.0});
+    }
+
+    static Relation relate(const circle& a, const circle& b) {
+        double dx = b.x - a.x, dy = b.y - a.y;
+        double sum = a.r + b.r;
+        if (dx * dx + dy * dy > 2 * sum * sum) return DISJOINT; // Далеко - без корня
+        double d = std::hypot(dx, dy);
+        double eps = tolerance(a, b);
+        if (d >= sum - eps) return DISJOINT;
+        if (d <= b.r - a.r + eps) return INSIDE;
+        if (d <= a.r - b.r + eps) return CONTAINS;
+        return OVERLAP;
+    }
+
+    // Совпадающие (в пределах допуска) круги и круги нулевого радиуса убираются
+    static std::vector<circle> unique(const std::vector<circle>& input) {
+        std::vector<circle> result;
+        for (const circle& c : input) {
+            if (c.r <= 0) continue;
+            bool duplicate = false;
+            for (const circle& kept : result) {
+                double eps = tolerance(c, kept);
+                if (std::abs(c.x - kept.x) <= eps && std::abs(c.y - kept.y) <= eps &&
+                    std::abs(c.r - kept.r) <= eps) {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if (!duplicate) result.push_back(c);
+        }
+        return result;
+    }
+
+    // Дуга окружности a внутри круга b: центр в направлении на b, полуширина по теореме косинусов.
+    // Интервал приводится к [0, 2pi) и при переходе через 0 делится на два
+    static void addArc(const circle& a, const circle& b, std::vector<Event>& events) {
+        double dx = b.x - a.x, dy = b.y - a.y;
+        double d = std::hypot(dx, dy);
+        double cosine = (a.r * a.r + d * d - b.r * b.r) / (2 * a.r * d);
+        double half = std::acos(std::min(1.0, std::max(-1.0, cosine)));
+        double start = std::atan2(dy, dx) - half;
+        double end = start + 2 * half;
+        const double full = 2 * M_PI;
+        while (start < 0) {
+            start += full;
+            end += full;
+        }
+        while (start >= full) {
+            start -= full;
+            end -= full;
+        }
+        if (end <= full) {
+            events.push_back({start, +1});
+            events.push_back({end, -1});
+        } else {
+            events.push_back({start, +1});
+            events.push_back({full, -1});
+            events.push_back({0, +1});
+            events.push_back({end - full, -1});
+        }
+    }
+
+    // 1/2 * интеграл (x dy - y dx) по дуге окружности c от угла a до b против часовой
+    static double greenArc(const circle& c, double a, double b) {
+        return 0.5 * (c.r * c.r * (b - a) + c.x * c.r * (std::sin(b) - std::sin(a)) -
+                      c.y * c.r * (std::cos(b) - std::cos(a)));
+    }
+
+    // Сумма по участкам окружности, где число покрывающих дуг удовлетворяет take(count)
+    template <typename Predicate>
+    static double sweep(const circle& c, std::vector<Event>& events, Predicate take) {
+        std::sort(events.begin(), events.end());
+        double area = 0;
+        double previous = 0;
+        int count = 0;
+        for (const Event& e : events) {
+            if (e.angle > previous && take(count)) {
+                area += greenArc(c, previous, e.angle);
+            }
+            previous = std::max(previous, e.angle);
+            count += e.delta;
+        }
+        if (previous < 2 * M_PI && take(count)) {
+            area += greenArc(c, previous, 2 * M_PI);
+        }
+        return area;
+    }
+};
+
+#endif
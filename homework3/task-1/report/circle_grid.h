@@ -0,0 +1,178 @@
+#ifndef CIRCLE_GRID_H
+#define CIRCLE_GRID_H
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "circle.h"
+
+// Равномерная сетка над прямоугольником выборки для быстрых запросов к большому
+// числу кругов. Для каждой клетки заранее известно:
+//  - сколько кругов покрывают ее целиком (для них точку проверять не нужно);
+//  - список кругов, граница которых проходит через клетку (только их и проверяем).
+// Списки всех клеток лежат подряд в одном массиве (CSR), координаты кругов
+// скопированы прямо в список - без косвенных обращений.
+class CircleGrid {
+public:
+    // cells_per_axis = 0 - подобрать по среднему радиусу: клетка порядка радиуса,
+    // тогда через клетку проходит в среднем несколько границ при любом числе кругов
+    CircleGrid(const std::vector<circle>& circles,
+               double x_min, double x_max,
+               double y_min, double y_max,
+               int cells_per_axis = 0)
+        : x_min(x_min), y_min(y_min), circle_count(circles.size()) {
+        if (cells_per_axis <= 0) {
+            double mean_r = 0;
+            for (const circle& c : circles) mean_r += c.r;
+            mean_r = circles.empty() ? 1 : mean_r / circles.size();
+            double extent = std::max(x_max - x_min, y_max - y_min);
+            cells_per_axis = (int)std::ceil(extent / std::max(mean_r, 1e-12));
+            cells_per_axis = std::min(std::max(cells_per_axis, 1), 2048);
+        }
+        nx = ny = cells_per_axis;
+        cell_w = (x_max - x_min) / nx;
+        cell_h = (y_max - y_min) / ny;
+
+        full.assign(nx * ny, 0);
+        start.assign(nx * ny + 1, 0);
+
+        // Два прохода: сначала размеры списков, затем заполнение
+        for (int pass = 0; pass < 2; pass++) {
+            std::vector<int> fill;
+            if (pass == 1) {
+                for (int cell = 0; cell < nx * ny; cell++) start[cell + 1] += start[cell];
+                entries.resize(start[nx * ny]);
+                fill.assign(start.begin(), start.end() - 1);
+            }
+            for (const circle& c : circles) {
+                int cx0 = cellX(c.x - c.r), cx1 = cellX(c.x + c.r);
+                int cy0 = cellY(c.y - c.r), cy1 = cellY(c.y + c.r);
+                for (int cy = cy0; cy <= cy1; cy++) {
+                    for (int cx = cx0; cx <= cx1; cx++) {
+                        int cell = cy * nx + cx;
+                        double left = x_min + cx * cell_w, bottom = y_min + cy * cell_h;
+                        int relation = classify(c, left, bottom, left + cell_w, bottom + cell_h);
+                        if (relation == FULL) {
+                            if (pass == 0) full[cell]++;
+                        } else if (relation == PARTIAL) {
+                            if (pass == 0) {
+                                start[cell + 1]++;
+                            } else {
+                                entries[fill[cell]++] = {c.x, c.y, c.r * c.r};
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Сколько кругов покрывают точку; подсчет прекращается, как только набрано k
+    int coverage(double x, double y, int k) const {
+        int cx = std::min(std::max((int)((x - x_min) / cell_w), 0), nx - 1);
+        int cy = std::min(std::max((int)((y - y_min) / cell_h), 0), ny - 1);
+        return coverageInCell(cy * nx + cx, x, y, k);
+    }
+
+    // Площадь части прямоугольника, покрытой хотя бы k кругами (Монте-Карло).
+    // Точки бросаются по клеткам (плиткам): все точки клетки проверяются против
+    // одного короткого списка, который остается в кэше. Клетки, где ответ известен
+    // без точек (k кругов покрывают клетку целиком или кругов меньше k), считаются
+    // точно. Каждая клетка - отдельная страта, поэтому оценка еще и точнее
+    // равномерной выборки с тем же числом точек
+    double monteCarloArea(int k, long long n_points, std::mt19937& gen) const {
+        const int cells = nx * ny;
+        const double cell_area = cell_w * cell_h;
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+        double area = 0;
+        for (int cell = 0; cell < cells; cell++) {
+            int partial = start[cell + 1] - start[cell];
+            if (full[cell] >= k) {
+                area += cell_area;
+                continue;
+            }
+            if (full[cell] + partial < k) {
+                continue;
+            }
+            long long n = n_points / cells + (cell < n_points % cells ? 1 : 0);
+            if (n == 0) n = 1;
+
+            double left = x_min + (cell % nx) * cell_w;
+            double bottom = y_min + (cell / nx) * cell_h;
+            long long inside = 0;
+            for (long long i = 0; i < n; i++) {
+                double x = left + unit(gen) * cell_w;
+                double y = bottom + unit(gen) * cell_h;
+                inside += coverageInCell(cell, x, y, k) >= k;
+            }
+            area += cell_area * inside / n;
+        }
+        return area;
+    }
+
+    double unionArea(long long n_points, std::mt19937& gen) const {
+        return monteCarloArea(1, n_points, gen);
+    }
+
+    double intersectionArea(long long n_points, std::mt19937& gen) const {
+        return circle_count == 0 ? 0 : monteCarloArea((int)circle_count, n_points, gen);
+    }
+
+    int cellsPerAxis() const { return nx; }
+
+    // Средняя длина списка проверяемых кругов на клетку
+    double meanCandidates() const { return (double)entries.size() / (nx * ny); }
+
+private:
+    enum Relation { OUTSIDE, PARTIAL, FULL };
+
+    struct Entry {
+        double x, y, r2;
+    };
+
+    double x_min, y_min;
+    double cell_w, cell_h;
+    int nx, ny;
+    size_t circle_count;
+    std::vector<int> full;      // Кругов, целиком покрывающих клетку
+    std::vector<int> start;     // Начало списка клетки в entries
+    std::vector<Entry> entries; // Круги, граница которых пересекает клетку
+
+    int cellX(double x) const {
+        return std::min(std::max((int)std::floor((x - x_min) / cell_w), 0), nx - 1);
+    }
+
+    int cellY(double y) const {
+        return std::min(std::max((int)std::floor((y - y_min) / cell_h), 0), ny - 1);
+    }
+
+    static int classify(const circle& c, double left, double bottom, double right, double top) {
+        // Ближайшая к центру точка клетки дальше радиуса - круг клетку не задевает
+        double dx = std::max(left, std::min(c.x, right)) - c.x;
+        double dy = std::max(bottom, std::min(c.y, top)) - c.y;
+        double r2 = c.r * c.r;
+        if (dx * dx + dy * dy > r2) {
+            return OUTSIDE;
+        }
+        // Самый дальний угол внутри - внутри вся клетка
+        double fx = std::max(std::abs(left - c.x), std::abs(right - c.x));
+        double fy = std::max(std::abs(bottom - c.y), std::abs(top - c.y));
+        return fx * fx + fy * fy <= r2 ? FULL : PARTIAL;
+    }
+
+    int coverageInCell(int cell, double x, double y, int k) const {
+        int count = full[cell];
+        if (count >= k) return count;
+        for (int i = start[cell]; i < start[cell + 1]; i++) {
+            double dx = x - entries[i].x, dy = y - entries[i].y;
+            if (dx * dx + dy * dy <= entries[i].r2 && ++count >= k) {
+                break;
+            }
+        }
+        return count;
+    }
+};
+
+#endif
@@ -4,38 +4,26 @@
 #include <cmath>
 #include <fstream>
 #include <chrono>
+#include "circle.h"
+#include "circle_area.h"
+#include "circle_grid.h"
 
 using namespace std;
 
-class circle {
-public:
-    double x, y, r;
-    
-    void input() {
-        cin >> x >> y >> r;
-    }
-    
-     bool dotInside(double a, double b) const {
-        return (sqrt((x - a) * (x - a) + (y - b) * (y - b)) <= r);
-    }
-};
-
-double exactArea() {
-    return 0.25 * M_PI + 1.25 * asin(0.8) - 1;
+// Точная площадь пересечения для любого набора кругов (дуги границы + формула Грина).
+// Для трех кругов из main совпадает с замкнутой формулой pi/4 + 1.25 * asin(0.8) - 1
+double exactArea(const vector<circle>& circles) {
+    return CircleArea::intersectionArea(circles);
 }
 
-double monteCarloArea(const vector<circle>& circles, 
-                     double x_min, double x_max, 
-                     double y_min, double y_max, 
-                     int n_points) {
-    random_device rd;
-    mt19937 gen(rd());
-    uniform_real_distribution<double> x_dist(x_min, x_max);
-    uniform_real_distribution<double> y_dist(y_min, y_max);
+// Сколько из n_points случайных точек прямоугольника попало во все круги
+long long countInside(const vector<circle>& circles, mt19937& gen,
+                      uniform_real_distribution<double>& x_dist,
+                      uniform_real_distribution<double>& y_dist,
+                      long long n_points) {
+    long long inside_count = 0;
     
-    int inside_count = 0;
-    
-    for (int i = 0; i < n_points; i++) {
+    for (long long i = 0; i < n_points; i++) {
         double x = x_dist(gen);
         double y = y_dist(gen);
         
@@ -51,11 +39,96 @@ double monteCarloArea(const vector<circle>& circles,
             inside_count++;
         }
     }
+    return inside_count;
+}
+
+double monteCarloArea(const vector<circle>& circles, 
+                     double x_min, double x_max, 
+                     double y_min, double y_max, 
+                     int n_points) {
+    random_device rd;
+    mt19937 gen(rd());
+    uniform_real_distribution<double> x_dist(x_min, x_max);
+    uniform_real_distribution<double> y_dist(y_min, y_max);
+    
+    long long inside_count = countInside(circles, gen, x_dist, y_dist, n_points);
     
     double area_rect = (x_max - x_min) * (y_max - y_min);
     return ((double)(inside_count) / n_points) * area_rect;
 }
 
+// Квантиль нормального распределения для двустороннего уровня доверия
+// (0.95 -> 1.96): бисекция по Phi(z) = (1 + confidence) / 2
+double normalQuantile(double confidence) {
+    double target = (1 + confidence) / 2;
+    double lo = 0, hi = 10;
+    for (int i = 0; i < 100; i++) {
+        double mid = (lo + hi) / 2;
+        if (0.5 * erfc(-mid / sqrt(2.0)) < target) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo + hi) / 2;
+}
+
+struct PrecisionEstimate {
+    double area;         // Оценка площади
+    double low, high;    // Доверительный интервал площади
+    long long samples;   // Сколько точек понадобилось
+    bool reached;        // Достигнута ли точность до лимита точек
+};
+
+// Площадь с заданной относительной погрешностью вместо заданного числа точек.
+// Точки бросаются пачками; после каждой пачки пересчитывается интервал Уилсона
+// для доли попаданий p (попадание - 0 или 1, так что счетчика попаданий достаточно,
+// отдельное среднее/дисперсия по Уэлфорду не нужны). Интервал Уилсона не вырождается
+// при p около 0 и 1, в отличие от нормального приближения.
+// Останавливаемся, как только полуширина интервала <= target_relative_error * оценка.
+// Первые min_points точек бросаются без проверки: на малых выборках
+// интервал слишком неточен, а частые проверки завышают реальную ошибку
+PrecisionEstimate monteCarloAreaToPrecision(const vector<circle>& circles,
+                                            double x_min, double x_max,
+                                            double y_min, double y_max,
+                                            double target_relative_error,
+                                            double confidence = 0.95,
+                                            long long max_points = 1000000000,
+                                            long long batch = 10000,
+                                            long long min_points = 10000) {
+    random_device rd;
+    mt19937 gen(rd());
+    uniform_real_distribution<double> x_dist(x_min, x_max);
+    uniform_real_distribution<double> y_dist(y_min, y_max);
+
+    double area_rect = (x_max - x_min) * (y_max - y_min);
+    double z = normalQuantile(confidence);
+    double z2 = z * z;
+
+    PrecisionEstimate result = {0, 0, area_rect, 0, false};
+    long long inside_count = 0;
+    while (result.samples < max_points) {
+        long long n = min(batch, max_points - result.samples);
+        inside_count += countInside(circles, gen, x_dist, y_dist, n);
+        result.samples += n;
+
+        double total = (double)result.samples;
+        double p = inside_count / total;
+        double center = (p + z2 / (2 * total)) / (1 + z2 / total);
+        double half = z / (1 + z2 / total) * sqrt(p * (1 - p) / total + z2 / (4 * total * total));
+        result.area = p * area_rect;
+        result.low = max(0.0, center - half) * area_rect;
+        result.high = min(1.0, center + half) * area_rect;
+
+        if (result.samples >= min_points && inside_count > 0 &&
+            half * area_rect <= target_relative_error * result.area) {
+            result.reached = true;
+            break;
+        }
+    }
+    return result;
+}
+
 void runExperiment(const vector<circle>& circles, 
                   const string& filename,
                   double x_min, double x_max,
@@ -63,7 +136,7 @@ void runExperiment(const vector<circle>& circles,
     ofstream file(filename);
     file << "N,ApproximateArea,RelativeError,TimeMs\n";
     
-    double exact_area = exactArea();
+    double exact_area = exactArea(circles);
     
     for (int n = 100; n <= 100000; n += 500) {
         auto start = chrono::high_resolution_clock::now();
@@ -84,6 +157,120 @@ void runExperiment(const vector<circle>& circles,
     }
     
     file.close();
+
+    // Время до заданной точности: сколько точек и миллисекунд стоит каждая цель
+    string precision_filename = filename.substr(0, filename.rfind(".csv")) + "_time_to_accuracy.csv";
+    ofstream precision_file(precision_filename);
+    precision_file << "TargetError,Confidence,Samples,ApproximateArea,IntervalLow,IntervalHigh,"
+                   << "RelativeError,TimeMs\n";
+
+    const double confidence = 0.95;
+    for (double target : {0.1, 0.05, 0.02, 0.01, 0.005, 0.002, 0.001}) {
+        auto start = chrono::high_resolution_clock::now();
+        PrecisionEstimate estimate = monteCarloAreaToPrecision(circles, x_min, x_max, y_min, y_max,
+                                                               target, confidence);
+        auto end = chrono::high_resolution_clock::now();
+        double time_ms = chrono::duration<double, milli>(end - start).count();
+        double relative_error = abs(estimate.area - exact_area) / exact_area;
+
+        precision_file << target << "," << confidence << "," << estimate.samples << ","
+                       << estimate.area << "," << estimate.low << "," << estimate.high << ","
+                       << relative_error << "," << time_ms << "\n";
+
+        cout << "Target " << target * 100 << "%: N=" << estimate.samples
+             << ", Area=" << estimate.area << " [" << estimate.low << ", " << estimate.high << "]"
+             << ", Error=" << relative_error * 100 << "%, " << time_ms << "ms"
+             << (estimate.reached ? "" : " (point limit reached)") << "\n";
+    }
+}
+
+// Объединение перебором всех кругов - для сравнения с сеткой
+double naiveUnionArea(const vector<circle>& circles,
+                      double x_min, double x_max,
+                      double y_min, double y_max,
+                      long long n_points, mt19937& gen) {
+    uniform_real_distribution<double> x_dist(x_min, x_max);
+    uniform_real_distribution<double> y_dist(y_min, y_max);
+    long long inside_count = 0;
+    for (long long i = 0; i < n_points; i++) {
+        double x = x_dist(gen);
+        double y = y_dist(gen);
+        for (const auto& circle : circles) {
+            if (circle.dotInside(x, y)) {
+                inside_count++;
+                break;
+            }
+        }
+    }
+    return ((double)inside_count / n_points) * (x_max - x_min) * (y_max - y_min);
+}
+
+// Пропускная способность от 3 до 10^5 кругов: сетка против перебора.
+// Круги случайные в [0, 10] x [0, 10], радиус ~ 10 / sqrt(count), чтобы при любом
+// числе кругов они покрывали заметную, но не всю площадь. Круги целиком внутри квадрата,
+// поэтому ошибки обеих оценок можно считать от точной площади объединения.
+// Точный расчет в худшем случае квадратичен, для самого большого набора он пропускается
+void runScalingExperiment(const string& filename) {
+    ofstream file(filename);
+    file << "Circles,Points,GridCells,MeanCandidates,GridBuildMs,GridUnionArea,GridMs,GridPointsPerSec,"
+         << "NaiveUnionArea,NaiveMs,NaivePointsPerSec,ExactUnionArea,ExactMs,GridRelativeError,NaiveRelativeError\n";
+
+    const double lo = 0, hi = 10;
+    const long long n_points = 1000000;
+    mt19937 gen(12345);
+
+    for (int count : {3, 30, 300, 3000, 30000, 100000}) {
+        vector<circle> circles(count);
+        double mean_r = (hi - lo) / sqrt((double)count);
+        uniform_real_distribution<double> radius(0.5 * mean_r, 1.5 * mean_r);
+        for (auto& c : circles) {
+            c.r = min(radius(gen), (hi - lo) / 2);
+            uniform_real_distribution<double> pos(lo + c.r, hi - c.r);
+            c.x = pos(gen);
+            c.y = pos(gen);
+        }
+
+        auto start = chrono::high_resolution_clock::now();
+        CircleGrid grid(circles, lo, hi, lo, hi);
+        auto end = chrono::high_resolution_clock::now();
+        double build_ms = chrono::duration<double, milli>(end - start).count();
+
+        start = chrono::high_resolution_clock::now();
+        double grid_area = grid.unionArea(n_points, gen);
+        end = chrono::high_resolution_clock::now();
+        double grid_ms = chrono::duration<double, milli>(end - start).count();
+
+        // Перебор на больших наборах слишком долгий: меньше точек, пересчет на секунду
+        long long naive_points = count <= 300 ? n_points : max(1000LL, n_points * 300 / count);
+        start = chrono::high_resolution_clock::now();
+        double naive_area = naiveUnionArea(circles, lo, hi, lo, hi, naive_points, gen);
+        end = chrono::high_resolution_clock::now();
+        double naive_ms = chrono::duration<double, milli>(end - start).count();
+
+        double exact_area = NAN, exact_ms = NAN;
+        if (count <= 30000) {
+            start = chrono::high_resolution_clock::now();
+            exact_area = CircleArea::unionArea(circles);
+            end = chrono::high_resolution_clock::now();
+            exact_ms = chrono::duration<double, milli>(end - start).count();
+        }
+        double grid_error = abs(grid_area - exact_area) / exact_area;
+        double naive_error = abs(naive_area - exact_area) / exact_area;
+
+        double grid_rate = n_points / (grid_ms / 1000);
+        double naive_rate = naive_points / (naive_ms / 1000);
+        file << count << "," << n_points << "," << grid.cellsPerAxis() * grid.cellsPerAxis() << ","
+             << grid.meanCandidates() << "," << build_ms << "," << grid_area << "," << grid_ms << "," << grid_rate << ","
+             << naive_area << "," << naive_ms << "," << naive_rate << ","
+             << exact_area << "," << exact_ms << "," << grid_error << "," << naive_error << "\n";
+        cout << "Circles=" << count << ": grid " << grid_rate / 1e6 << "M points/s (area " << grid_area
+             << ", build " << build_ms << "ms), naive " << naive_rate / 1e6 << "M points/s (area " << naive_area << ")";
+        if (count <= 30000) {
+            cout << ", exact " << exact_area << " in " << exact_ms << "ms (grid error " << grid_error * 100
+                 << "%, naive error " << naive_error * 100 << "%)";
+        }
+        cout << "\n";
+    }
 }
 
 int main() {
@@ -92,8 +279,12 @@ int main() {
     circles[1].x = 1.5; circles[1].y = 2.0; circles[1].r = sqrt(5)/2;
     circles[2].x = 2.0; circles[2].y = 1.5; circles[2].r = sqrt(5)/2;
     
-    double exact_area = exactArea();
-    cout << "Exact area: " << exact_area << "\n\n";
+    // Быстрый ответ: точная площадь без случайных точек
+    auto start = chrono::high_resolution_clock::now();
+    double exact_area = exactArea(circles);
+    auto end = chrono::high_resolution_clock::now();
+    cout << "Exact area: " << exact_area << " (" << chrono::duration<double, micro>(end - start).count()
+         << " us)\n\n";
     
     // широкая [0, 3] x [0, 3]
     cout << "Running wide area experiment...\n";
@@ -102,5 +293,15 @@ int main() {
     // узкая [0.7, 2.1] x [0.7, 2.1] 
     cout << "\nRunning narrow area experiment...\n";
     runExperiment(circles, "narrow_area_results.csv", 0.7, 2.1, 0.7, 2.1);
+
+    // Те же три круга через сетку: пересечение = покрытие всеми тремя
+    mt19937 gen(random_device{}());
+    CircleGrid grid(circles, 0, 3, 0, 3);
+    double grid_area = grid.intersectionArea(1000000, gen);
+    cout << "\nGrid intersection (10^6 points): " << grid_area
+         << ", Error=" << abs(grid_area - exact_area) / exact_area * 100 << "%\n";
+
+    cout << "\nRunning scaling experiment...\n";
+    runScalingExperiment("grid_scaling_results.csv");
     
 }
\ No newline at end of file
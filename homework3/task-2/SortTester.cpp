@@ -1,5 +1,6 @@
 #include "SortTester.h"
 #include <vector>
+#include "../task-3/simd_sort.h"
 
 void SortTester::insertionSort(std::vector<int>& arr, int l, int r) {
     for (int i = l + 1; i <= r; ++i) {
@@ -31,6 +32,15 @@ void SortTester::merge(std::vector<int>& arr, int l, int m, int r) {
     while (j < n2) arr[k++] = R[j++];
 }
 
+// Векторное слияние, если есть AVX2, иначе обычное
+void SortTester::vectorMerge(std::vector<int>& arr, int l, int m, int r) {
+    int n1 = m - l + 1;
+    int n2 = r - m;
+    std::vector<int> L(arr.begin() + l, arr.begin() + m + 1);
+    std::vector<int> R(arr.begin() + m + 1, arr.begin() + r + 1);
+    SimdSort::mergeRuns(L.data(), n1, R.data(), n2, &arr[l]);
+}
+
 void SortTester::mergeSort(std::vector<int>& arr, int l, int r) {
     if (l < r) {
         int m = l + (r - l) / 2;
@@ -47,6 +57,26 @@ void SortTester::hybridMergeSort(std::vector<int>& arr, int l, int r, int thresh
         int m = l + (r - l) / 2;
         hybridMergeSort(arr, l, m, threshold);
         hybridMergeSort(arr, m + 1, r, threshold);
-        merge(arr, l, m, r);
+        // Нижние уровни сливаются векторно, верхние - как в mergeSort
+        if (r - l + 1 <= kVectorMergeMax) {
+            vectorMerge(arr, l, m, r);
+        } else {
+            merge(arr, l, m, r);
+        }
+    }
+}
+
+void SortTester::networkMergeSort(std::vector<int>& arr, int l, int r) {
+    if (r - l + 1 <= SimdSort::baseCaseLimit()) {
+        SimdSort::sortSmall(&arr[l], r - l + 1);
+    } else {
+        int m = l + (r - l) / 2;
+        networkMergeSort(arr, l, m);
+        networkMergeSort(arr, m + 1, r);
+        if (r - l + 1 <= kVectorMergeMax) {
+            vectorMerge(arr, l, m, r);
+        } else {
+            merge(arr, l, m, r);
+        }
     }
 }   
\ No newline at end of file
@@ -9,6 +9,9 @@ class SortTester {
 public:
     static void mergeSort(std::vector<int>& arr, int l, int r);
     static void hybridMergeSort(std::vector<int>& arr, int l, int r, int threshold);
+    // Отдельный вариант гибрида: вместо вставок до порога - сортирующая сеть
+    // на блоках до SimdSort::baseCaseLimit() элементов (task-3/simd_sort.h)
+    static void networkMergeSort(std::vector<int>& arr, int l, int r);
     
     template<typename Func, typename... Args>
     static long long measureTime(Func sortFunc, std::vector<int> arr, Args... args);
@@ -16,6 +19,10 @@ public:
 private:
     static void insertionSort(std::vector<int>& arr, int l, int r);
     static void merge(std::vector<int>& arr, int l, int m, int r);
+    static void vectorMerge(std::vector<int>& arr, int l, int m, int r);
+
+    // Векторное слияние - только на нижних уровнях, пока оба куска в L1 (16 КБ)
+    static const int kVectorMergeMax = 4096;
 };
 
 template<typename Func, typename... Args>
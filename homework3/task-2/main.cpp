@@ -3,8 +3,19 @@
 #include <vector>
 #include "ArrayGenerator.h"
 #include "SortTester.h"
+#include "../task-3/background_worker.h"
+#include "../task-3/result_history.h"
 #include <cmath>
-void runExperiments() {
+#include <memory>
+#include <sstream>
+#include <string>
+
+// Строки CSV копятся в памяти и уходят в файлы пачками на фоновом потоке,
+// чтобы запись на диск не попадала между замерами
+struct CsvBatch {
+    std::ostringstream rows[6];
+};
+void runExperiments(ResultHistory& history) {
     const int minSize = 500;
     const int maxSize = 100000;
     const int step = 100;
@@ -22,6 +33,27 @@ void runExperiments() {
     std::ofstream hybridReverse("hybrid_reverse.csv");
     std::ofstream hybridAlmost("hybrid_almost.csv");
     
+    std::ofstream* files[6] = {
+        &standardRandom, &standardReverse, &standardAlmost,
+        &hybridRandom, &hybridReverse, &hybridAlmost
+    };
+    const int batchSteps = 100; // Строк на файл в одной пачке
+
+    // Замеры - на отдельном ядре, запись - на фоновом потоке.
+    // Привязка снимается после остановки writer, при выходе из runExperiments
+    BackgroundWorker::ScopedPin pin(BackgroundWorker::measurementCore());
+    BackgroundWorker writer(BackgroundWorker::backgroundCore(0));
+    std::shared_ptr<CsvBatch> batch = std::make_shared<CsvBatch>();
+    auto flushBatch = [&]() {
+        writer.submit([batch, &files]() {
+            for (int i = 0; i < 6; i++) {
+                *files[i] << batch->rows[i].str();
+                files[i]->flush();
+            }
+        });
+        batch = std::make_shared<CsvBatch>();
+    };
+
     standardRandom << "Size,Time\n";
     standardReverse << "Size,Time\n";
     standardAlmost << "Size,Time\n";
@@ -42,25 +74,40 @@ void runExperiments() {
         long long hybridRandomTime = SortTester::measureTime(SortTester::hybridMergeSort, randomSub, 0, size - 1, 10);
         long long hybridReverseTime = SortTester::measureTime(SortTester::hybridMergeSort, reverseSub, 0, size - 1, 10);
         long long hybridAlmostTime = SortTester::measureTime(SortTester::hybridMergeSort, almostSub, 0, size - 1, 10);
+
+        // Вариант с сортирующей сетью - только в историю, CSV для графиков прежние
+        long long networkRandomTime = SortTester::measureTime(SortTester::networkMergeSort, randomSub, 0, size - 1);
+        long long networkReverseTime = SortTester::measureTime(SortTester::networkMergeSort, reverseSub, 0, size - 1);
+        long long networkAlmostTime = SortTester::measureTime(SortTester::networkMergeSort, almostSub, 0, size - 1);
         
-        standardRandom << size << "," << standardRandomTime << "\n";
-        standardReverse << size << "," << standardReverseTime << "\n";
-        standardAlmost << size << "," << standardAlmostTime << "\n";
+        batch->rows[0] << size << "," << standardRandomTime << "\n";
+        batch->rows[1] << size << "," << standardReverseTime << "\n";
+        batch->rows[2] << size << "," << standardAlmostTime << "\n";
         
-        hybridRandom << size << "," << hybridRandomTime << "\n";
-        hybridReverse << size << "," << hybridReverseTime << "\n";
-        hybridAlmost << size << "," << hybridAlmostTime << "\n";
+        batch->rows[3] << size << "," << hybridRandomTime << "\n";
+        batch->rows[4] << size << "," << hybridReverseTime << "\n";
+        batch->rows[5] << size << "," << hybridAlmostTime << "\n";
+
+        // measureTime - в микросекундах, в истории - наносекунды
+        history.add("MergeSort", "RANDOM", size, standardRandomTime * 1000.0);
+        history.add("MergeSort", "REVERSED", size, standardReverseTime * 1000.0);
+        history.add("MergeSort", "ALMOST_SORTED", size, standardAlmostTime * 1000.0);
+        history.add("HybridMergeSort", "RANDOM", size, hybridRandomTime * 1000.0);
+        history.add("HybridMergeSort", "REVERSED", size, hybridReverseTime * 1000.0);
+        history.add("HybridMergeSort", "ALMOST_SORTED", size, hybridAlmostTime * 1000.0);
+        history.add("NetworkMergeSort", "RANDOM", size, networkRandomTime * 1000.0);
+        history.add("NetworkMergeSort", "REVERSED", size, networkReverseTime * 1000.0);
+        history.add("NetworkMergeSort", "ALMOST_SORTED", size, networkAlmostTime * 1000.0);
         
-        standardRandom.flush();
-        standardReverse.flush();
-        standardAlmost.flush();
-        hybridRandom.flush();
-        hybridReverse.flush();
-        hybridAlmost.flush();
+        if ((size - minSize) / step % batchSteps == batchSteps - 1) {
+            flushBatch();
+        }
     }
+    flushBatch();
+    writer.wait();
 }
 
-void testThresholds() {
+void testThresholds(ResultHistory& history) {
     const int testSize = 10000;
     const int numRuns = 10; // Количество запусков для каждого порога
     
@@ -79,6 +126,7 @@ void testThresholds() {
             
             long long time = SortTester::measureTime(SortTester::hybridMergeSort, arr, 0, testSize - 1, threshold);
             times.push_back(time);
+            history.add("HybridMergeSort_T" + std::to_string(threshold), "RANDOM", testSize, time * 1000.0);
         }
         
         // Вычисляем статистику
@@ -114,9 +162,11 @@ void testThresholds() {
 
 int main() {
     std::cout << "Starting experiments..." << std::endl;
-    runExperiments();
+    ResultHistory history("sorting_experiment");
+    runExperiments(history);
     std::cout << "Testing different thresholds..." << std::endl;
-    testThresholds();
+    testThresholds(history);
+    history.save();
     std::cout << "Experiments completed!" << std::endl;
     return 0;
 }
\ No newline at end of file
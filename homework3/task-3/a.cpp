@@ -1,148 +1,63 @@
-#include <vector>
-#include <algorithm>
-#include <cmath>
-#include <cstdlib>
-#include <ctime>
+#include <chrono>
+#include <cstring>
 #include <iostream>
-#include <bits/stdc++.h>
-class SortAlgorithms {
-private:
-    // Вспомогательные функции для Heap Sort
-    static void heapify(std::vector<int>& arr, int n, int i) {
-        int largest = i;
-        int left = 2 * i + 1;
-        int right = 2 * i + 2;
-
-        if (left < n && arr[left] > arr[largest])
-            largest = left;
-
-        if (right < n && arr[right] > arr[largest])
-            largest = right;
-
-        if (largest != i) {
-            std::swap(arr[i], arr[largest]);
-            heapify(arr, n, largest);
-        }
-    }
-
-    static void buildHeap(std::vector<int>& arr, int n) {
-        for (int i = n / 2 - 1; i >= 0; i--)
-            heapify(arr, n, i);
-    }
-
-    static int partition(std::vector<int>& arr, int low, int high) {
-        int randomIndex = low + rand() % (high - low + 1);
-        std::swap(arr[randomIndex], arr[high]);
-        
-        int pivot = arr[high];
-        int i = low - 1;
-
-        for (int j = low; j < high; j++) {
-            if (arr[j] <= pivot) {
-                i++;
-                std::swap(arr[i], arr[j]);
-            }
-        }
-        std::swap(arr[i + 1], arr[high]);
-        return i + 1;
-    }
-
-    static void insertionSort(std::vector<int>& arr, int low, int high) {
-        for (int i = low + 1; i <= high; i++) {
-            int key = arr[i];
-            int j = i - 1;
-
-            while (j >= low && arr[j] > key) {
-                arr[j + 1] = arr[j];
-                j--;
-            }
-            arr[j + 1] = key;
-        }
-    }
-
-    static void heapSortPartial(std::vector<int>& arr, int low, int high) {
-        int n = high - low + 1;
-        std::vector<int> temp(n);
-        
-        for (int i = 0; i < n; i++) {
-            temp[i] = arr[low + i];
-        }
-
-        buildHeap(temp, n);
-
-        for (int i = n - 1; i >= 0; i--) {
-            std::swap(temp[0], temp[i]);
-            heapify(temp, i, 0);
-        }
-
-        for (int i = 0; i < n; i++) {
-            arr[low + i] = temp[i];
-        }
-    }
-
-    static void quickSortStandardRecursive(std::vector<int>& arr, int low, int high) {
-        if (low < high) {
-            int pi = partition(arr, low, high);
-            quickSortStandardRecursive(arr, low, pi - 1);
-            quickSortStandardRecursive(arr, pi + 1, high);
-        }
-    }
-
-    static void quickSortHybridRecursive(std::vector<int>& arr, int low, int high, int depthLimit) {
-        if (high - low < 16) {
-            insertionSort(arr, low, high);
-            return;
-        }
-
-        if (depthLimit == 0) {
-            heapSortPartial(arr, low, high);
-            return;
-        }
-
-        // Обычный Quick Sort
-        int pi = partition(arr, low, high);
-        quickSortHybridRecursive(arr, low, pi - 1, depthLimit - 1);
-        quickSortHybridRecursive(arr, pi + 1, high, depthLimit - 1);
-    }
-
-public:
-    // Стандартный Quick Sort
-    static void quickSortStandard(std::vector<int>& arr) {
-        if (arr.size() <= 1) return;
-        quickSortStandardRecursive(arr, 0, arr.size() - 1);
-    }
-
-    // Гибридный Introsort
-    static void quickSortHybrid(std::vector<int>& arr) {
-        if (arr.size() <= 1) return;
-        
-        // Вычисляем максимальную глубину рекурсии: 2 * log2(n)
-        int depthLimit = 2 * static_cast<int>(log2(arr.size()));
-        quickSortHybridRecursive(arr, 0, arr.size() - 1, depthLimit);
-    }
-
-    // Insertion Sort (для сравнения)
-    static void insertionSort(std::vector<int>& arr) {
-        insertionSort(arr, 0, arr.size() - 1);
-    }
-
-    // Heap Sort (для сравнения)
-    static void heapSort(std::vector<int>& arr) {
-        int n = arr.size();
-        if (n <= 1) return;
+#include <string>
+#include <vector>
+#include "fast_io.h"
+#include "sort_algorithms.h"
 
-        buildHeap(arr, n);
+// Утилита сортировки больших массивов.
+//   ./SortTool [вход] [-o выход] [--binary-in] [--binary-out]
+// Текстовый вход: n, затем n чисел (как раньше для cin). Двоичный вход: сырые int32.
+// Без путей читает stdin и пишет stdout. Время фаз печатается в stderr.
 
-        for (int i = n - 1; i > 0; i--) {
-            std::swap(arr[0], arr[i]);
-            heapify(arr, i, 0);
-        }
-    }
-};
 using namespace std;
-int main(){
-    int n; cin >> n;
-    vector<int> arr(n);
-    for (int i = 0; i < n; i++) cin >> arr[i];
-    
-}
\ No newline at end of file
+
+static double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    string inputPath, outputPath;
+    bool binaryIn = false, binaryOut = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--binary-in") == 0) {
+            binaryIn = true;
+        } else if (strcmp(argv[i], "--binary-out") == 0) {
+            binaryOut = true;
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else {
+            inputPath = argv[i];
+        }
+    }
+
+    try {
+        auto start = chrono::steady_clock::now();
+        vector<int> arr;
+        {
+            FastIO::InputBuffer input = FastIO::readInput(inputPath);
+            arr = binaryIn ? FastIO::parseBinary(input) : FastIO::parseCounted(input);
+        }
+        double ingestMs = millisecondsSince(start);
+
+        start = chrono::steady_clock::now();
+        SortAlgorithms::quickSortHybrid(arr);
+        double sortMs = millisecondsSince(start);
+
+        start = chrono::steady_clock::now();
+        if (binaryOut) {
+            FastIO::writeBinary(outputPath, arr);
+        } else {
+            FastIO::writeText(outputPath, arr);
+        }
+        double emitMs = millisecondsSince(start);
+
+        cerr << "n=" << arr.size() << " ingest: " << ingestMs << "ms, sort: " << sortMs
+             << "ms, emit: " << emitMs << "ms" << endl;
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include "alloc_telemetry.h"
+
+#include <cstdlib>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+// Тривиальная структура: thread_local без динамической инициализации,
+// безопасна даже в new/delete во время запуска и завершения потока
+struct Counters {
+    size_t allocations;
+    size_t bytes;
+    long long live;
+    long long peak;
+};
+
+thread_local Counters counters;
+
+// Перед блоком хранится его размер. Заголовок 16 байт сохраняет
+// выравнивание malloc для обычных new
+constexpr size_t kHeader = 16;
+
+void track(size_t size) {
+    counters.allocations++;
+    counters.bytes += size;
+    counters.live += size;
+    if (counters.live > counters.peak) {
+        counters.peak = counters.live;
+    }
+}
+
+void* allocate(size_t size, size_t alignment) {
+    size_t header = alignment > kHeader ? alignment : kHeader;
+    void* raw = nullptr;
+    if (alignment > kHeader) {
+        if (posix_memalign(&raw, alignment, header + size) != 0) {
+            raw = nullptr;
+        }
+    } else {
+        raw = std::malloc(header + size);
+    }
+    if (!raw) {
+        return nullptr;
+    }
+    char* user = static_cast<char*>(raw) + header;
+    reinterpret_cast<size_t*>(user)[-1] = size;
+    track(size);
+    return user;
+}
+
+void* allocateOrThrow(size_t size, size_t alignment) {
+    while (true) {
+        if (void* p = allocate(size, alignment)) {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void release(void* p, size_t alignment) {
+    if (!p) {
+        return;
+    }
+    char* user = static_cast<char*>(p);
+    counters.live -= reinterpret_cast<size_t*>(user)[-1];
+    size_t header = alignment > kHeader ? alignment : kHeader;
+    std::free(user - header);
+}
+
+} // namespace
+
+AllocTelemetry::Scope::Scope() {
+    startRssKb = residentKb();
+    startAllocations = counters.allocations;
+    startBytes = counters.bytes;
+    startLive = counters.live;
+    counters.peak = counters.live;
+}
+
+AllocTelemetry::Stats AllocTelemetry::Scope::finish() {
+    Stats stats;
+    stats.allocations = counters.allocations - startAllocations;
+    stats.bytes = counters.bytes - startBytes;
+    stats.peakBytes = static_cast<size_t>(counters.peak - static_cast<long long>(startLive));
+    stats.rssDeltaKb = residentKb() - startRssKb;
+    return stats;
+}
+
+long AllocTelemetry::residentKb() {
+    // Без stdio: fopen сам выделил бы память
+    int fd = open("/proc/self/statm", O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    char buffer[128];
+    ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (length <= 0) {
+        return 0;
+    }
+    buffer[length] = '\0';
+    // Формат: size resident shared ... (в страницах)
+    char* p = buffer;
+    while (*p && *p != ' ') p++;
+    long pages = std::strtol(p, nullptr, 10);
+    return pages * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+long long AllocTelemetry::liveBytes() {
+    return counters.live;
+}
+
+void* operator new(size_t size) { return allocateOrThrow(size, 0); }
+void* operator new[](size_t size) { return allocateOrThrow(size, 0); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size, 0); }
+void* operator new(size_t size, std::align_val_t al) { return allocateOrThrow(size, static_cast<size_t>(al)); }
+void* operator new[](size_t size, std::align_val_t al) { return allocateOrThrow(size, static_cast<size_t>(al)); }
+void* operator new(size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<size_t>(al));
+}
+void* operator new[](size_t size, std::align_val_t al, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<size_t>(al));
+}
+
+void operator delete(void* p) noexcept { release(p, 0); }
+void operator delete[](void* p) noexcept { release(p, 0); }
+void operator delete(void* p, size_t) noexcept { release(p, 0); }
+void operator delete[](void* p, size_t) noexcept { release(p, 0); }
+void operator delete(void* p, std::align_val_t al) noexcept { release(p, static_cast<size_t>(al)); }
+void operator delete[](void* p, std::align_val_t al) noexcept { release(p, static_cast<size_t>(al)); }
+void operator delete(void* p, size_t, std::align_val_t al) noexcept { release(p, static_cast<size_t>(al)); }
+void operator delete[](void* p, size_t, std::align_val_t al) noexcept { release(p, static_cast<size_t>(al)); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { release(p, 0); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { release(p, 0); }
+void operator delete(void* p, std::align_val_t al, const std::nothrow_t&) noexcept {
+    release(p, static_cast<size_t>(al));
+}
+void operator delete[](void* p, std::align_val_t al, const std::nothrow_t&) noexcept {
+    release(p, static_cast<size_t>(al));
+}
@@ -0,0 +1,41 @@
+#ifndef ALLOC_TELEMETRY_H
+#define ALLOC_TELEMETRY_H
+
+#include <cstddef>
+
+// Учет выделений памяти. Глобальные operator new/delete подменены в
+// alloc_telemetry.cpp (его нужно добавить в сборку): каждый блок несет свой размер,
+// счетчики ведутся отдельно на каждый поток, поэтому фоновые потоки
+// не попадают в замеры основного.
+class AllocTelemetry {
+public:
+    struct Stats {
+        size_t allocations; // Число вызовов operator new
+        size_t bytes;       // Сколько байт запрошено всего
+        size_t peakBytes;   // Максимум живой памяти сверх той, что была на входе в замер
+        long rssDeltaKb;    // Изменение резидентной памяти процесса (на весь процесс)
+    };
+
+    // Замер от создания до finish(). Вложенные замеры в одном потоке не поддерживаются.
+    // Сам замер ничего не выделяет
+    class Scope {
+    public:
+        Scope();
+        Stats finish();
+
+    private:
+        size_t startAllocations;
+        size_t startBytes;
+        size_t startLive;
+        long startRssKb;
+    };
+
+    // Резидентная память процесса по /proc/self/statm (0, если недоступно)
+    static long residentKb();
+
+    // Живая память, выделенная текущим потоком (может быть отрицательной, если
+    // поток освобождал чужие блоки)
+    static long long liveBytes();
+};
+
+#endif
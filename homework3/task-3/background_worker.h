@@ -0,0 +1,149 @@
+#ifndef BACKGROUND_WORKER_H
+#define BACKGROUND_WORKER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Фоновый поток с очередью задач: генерация данных, проверки и запись CSV
+// выполняются на нем, пока основной поток замеряет сортировку.
+// Задачи выполняются строго по очереди, в порядке отправки.
+class BackgroundWorker {
+public:
+    // core < 0 - без привязки к ядру
+    explicit BackgroundWorker(int core = -1) : stopping(false), busy(false) {
+        thread = std::thread([this, core] {
+            if (core >= 0) {
+                pinCurrentThread(core);
+            }
+            loop();
+        });
+    }
+
+    BackgroundWorker(const BackgroundWorker&) = delete;
+    BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+
+    // Дожидается всех отправленных задач
+    ~BackgroundWorker() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        thread.join();
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        wakeup.notify_all();
+    }
+
+    // Ждать, пока очередь опустеет и текущая задача завершится
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return tasks.empty() && !busy; });
+    }
+
+    // Привязать текущий поток к ядру. Возвращает false, если не удалось
+    // (не Linux, ядра нет в доступном наборе)
+    static bool pinCurrentThread(int core) {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)core;
+        return false;
+#endif
+    }
+
+    // Привязка текущего потока к ядру на время области видимости: в деструкторе
+    // возвращается прежний набор ядер. core < 0 - поток не трогается
+    class ScopedPin {
+    public:
+        explicit ScopedPin(int core) : restore(false) {
+#ifdef __linux__
+            if (core >= 0 && pthread_getaffinity_np(pthread_self(), sizeof(saved), &saved) == 0) {
+                restore = pinCurrentThread(core);
+            }
+#else
+            (void)core;
+#endif
+        }
+
+        ScopedPin(const ScopedPin&) = delete;
+        ScopedPin& operator=(const ScopedPin&) = delete;
+
+        ~ScopedPin() {
+#ifdef __linux__
+            if (restore) {
+                pthread_setaffinity_np(pthread_self(), sizeof(saved), &saved);
+            }
+#endif
+        }
+
+    private:
+        bool restore;
+#ifdef __linux__
+        cpu_set_t saved;
+#endif
+    };
+
+    // Ядра, доступные процессу. Основной поток с замерами берет последнее,
+    // фоновые - остальные. На одном ядре разводить нечего: возвращает -1
+    static int measurementCore() {
+        int count = availableCores();
+        return count > 1 ? count - 1 : -1;
+    }
+
+    static int backgroundCore(int index) {
+        int count = availableCores();
+        return count > 1 ? index % (count - 1) : -1;
+    }
+
+private:
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable idle;
+    std::deque<std::function<void()>> tasks;
+    bool stopping;
+    bool busy;
+
+    static int availableCores() {
+        unsigned count = std::thread::hardware_concurrency();
+        return count == 0 ? 1 : static_cast<int>(count);
+    }
+
+    void loop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wakeup.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return; // stopping и все задачи выполнены
+            }
+            std::function<void()> task = std::move(tasks.front());
+            tasks.pop_front();
+            busy = true;
+            lock.unlock();
+            task();
+            lock.lock();
+            busy = false;
+            if (tasks.empty()) {
+                idle.notify_all();
+            }
+        }
+    }
+};
+
+#endif
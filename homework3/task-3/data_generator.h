@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <random>
 #include <functional>
+#include <string>
+#include "string_arena.h"
 
 class DataGenerator {
 public:
@@ -91,4 +93,130 @@ private:
     }
 };
 
+// Наборы строковых ключей для string_sort.h: строки сразу складываются в арену
+class StringDataGenerator {
+public:
+    enum DataType {
+        RANDOM,        // Случайные строки из [a-z] длиной 8-32: различаются с первых байт
+        URLS,          // URL: немного популярных доменов, пути из словаря, числовые id
+        SHARED_PREFIX, // Общий префикс 48 байт, один из 16 подпрефиксов и случайный хвост
+        FEW_UNIQUE,    // 100 различных строк, каждая повторяется много раз
+        PREFIX_CHAIN   // "a", "aa", "aaa", ...: каждая строка - префикс более длинных
+    };
+
+    static const char* name(DataType type) {
+        switch (type) {
+            case RANDOM: return "RANDOM";
+            case URLS: return "URLS";
+            case SHARED_PREFIX: return "SHARED_PREFIX";
+            case FEW_UNIQUE: return "FEW_UNIQUE";
+            case PREFIX_CHAIN: return "PREFIX_CHAIN";
+        }
+        return "UNKNOWN";
+    }
+
+    static StringArena generateData(int size, DataType type, unsigned seed = 42) {
+        std::mt19937 gen(seed);
+        StringArena arena;
+        arena.reserve(size, static_cast<size_t>(size) * 48);
+        std::string s;
+
+        switch (type) {
+            case RANDOM:
+                for (int i = 0; i < size; i++) {
+                    randomWord(gen, s, 8, 32);
+                    arena.add(s);
+                }
+                break;
+            case URLS:
+                for (int i = 0; i < size; i++) {
+                    url(gen, s);
+                    arena.add(s);
+                }
+                break;
+            case SHARED_PREFIX: {
+                const std::string prefix = "/var/log/cluster-eu-west/storage-node/2026-10-19/";
+                std::vector<std::string> subPrefixes(16);
+                for (std::string& sub : subPrefixes) {
+                    randomWord(gen, sub, 16, 16);
+                }
+                std::uniform_int_distribution<int> pick(0, 15);
+                std::string tail;
+                for (int i = 0; i < size; i++) {
+                    randomWord(gen, tail, 4, 12);
+                    s = prefix + subPrefixes[pick(gen)] + "/" + tail;
+                    arena.add(s);
+                }
+                break;
+            }
+            case FEW_UNIQUE: {
+                std::vector<std::string> unique(100);
+                for (std::string& word : unique) {
+                    randomWord(gen, word, 8, 24);
+                }
+                std::uniform_int_distribution<int> pick(0, 99);
+                for (int i = 0; i < size; i++) {
+                    arena.add(unique[pick(gen)]);
+                }
+                break;
+            }
+            case PREFIX_CHAIN: {
+                // Глубина по байтам до 2500, но не больше ~64 МБ текста на весь набор
+                int maxLength = std::max(1, std::min(2500, (1 << 27) / std::max(size, 1)));
+                std::vector<int> lengths(size);
+                for (int i = 0; i < size; i++) {
+                    lengths[i] = i % maxLength + 1;
+                }
+                std::shuffle(lengths.begin(), lengths.end(), gen);
+                for (int length : lengths) {
+                    s.assign(length, 'a');
+                    arena.add(s);
+                }
+                break;
+            }
+        }
+        return arena;
+    }
+
+private:
+    static void randomWord(std::mt19937& gen, std::string& s, int minLength, int maxLength) {
+        std::uniform_int_distribution<int> length(minLength, maxLength);
+        std::uniform_int_distribution<int> letter('a', 'z');
+        s.resize(length(gen));
+        for (char& c : s) {
+            c = static_cast<char>(letter(gen));
+        }
+    }
+
+    // Домены и слова пути выбираются с перекосом (геометрически): как в реальных логах,
+    // большая часть ключей делит несколько длинных префиксов
+    static void url(std::mt19937& gen, std::string& s) {
+        static const char* domains[] = {
+            "example.com", "wikipedia.org", "github.com", "news.ycombinator.com", "stackoverflow.com",
+            "docs.python.org", "en.cppreference.com", "mail.google.com", "youtube.com", "reddit.com",
+            "amazon.com", "market.yandex.ru", "habr.com", "lenta.ru", "vk.com", "ok.ru"
+        };
+        static const char* words[] = {
+            "wiki", "questions", "users", "search", "item", "catalog", "article", "blob", "master",
+            "src", "include", "reference", "watch", "comments", "images", "api", "v1", "v2", "static",
+            "news", "category", "product", "profile", "settings", "tags", "page"
+        };
+        std::geometric_distribution<int> skew(0.3);
+        std::uniform_int_distribution<int> segments(1, 4);
+        std::uniform_int_distribution<int> id(1, 9999999);
+        std::uniform_int_distribution<int> coin(0, 3);
+
+        s = coin(gen) == 0 ? "http://" : "https://";
+        if (coin(gen) != 0) s += "www.";
+        s += domains[std::min(skew(gen), 15)];
+        for (int k = segments(gen); k > 0; k--) {
+            s += "/";
+            s += words[std::min(skew(gen), 25)];
+        }
+        if (coin(gen) != 0) {
+            s += "?id=" + std::to_string(id(gen));
+        }
+    }
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,291 @@
+#ifndef FAST_IO_H
+#define FAST_IO_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Быстрый ввод-вывод больших массивов int: на 10^8 чисел разбор через iostream
+// занимает больше времени, чем сама сортировка.
+// Вход целиком отображается в память (файл) или читается большими блоками (stdin),
+// цифры разбираются по 8 за раз внутри 64-битного слова (SWAR), вывод
+// форматируется парами цифр в большой буфер и пишется одним системным вызовом на блок.
+class FastIO {
+public:
+    // Непрерывный буфер с входными данными: отображение файла или копия stdin
+    class InputBuffer {
+    public:
+        InputBuffer() = default;
+        InputBuffer(const InputBuffer&) = delete;
+        InputBuffer& operator=(const InputBuffer&) = delete;
+
+        InputBuffer(InputBuffer&& other) noexcept
+            : mapped(other.mapped), mappedSize(other.mappedSize), owned(std::move(other.owned)) {
+            other.mapped = nullptr;
+            other.mappedSize = 0;
+        }
+
+        ~InputBuffer() {
+            if (mapped) {
+                munmap(mapped, mappedSize);
+            }
+        }
+
+        const char* begin() const { return mapped ? static_cast<const char*>(mapped) : owned.data(); }
+        const char* end() const { return begin() + size(); }
+        size_t size() const { return mapped ? mappedSize : owned.size(); }
+
+    private:
+        friend class FastIO;
+
+        void* mapped = nullptr;
+        size_t mappedSize = 0;
+        std::vector<char> owned;
+    };
+
+    // Файл - через mmap, "-" или пустой путь - чтение stdin в буфер, растущий вдвое
+    static InputBuffer readInput(const std::string& path) {
+        InputBuffer buffer;
+        if (path.empty() || path == "-") {
+            readAll(STDIN_FILENO, buffer.owned);
+            return buffer;
+        }
+
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open input file: " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw std::runtime_error("Cannot stat input file: " + path);
+        }
+        // Канал, /dev/stdin, <(...) и файлы /proc сообщают размер 0 - их читаем как поток
+        void* data = MAP_FAILED;
+        if (S_ISREG(info.st_mode) && info.st_size > 0) {
+            data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        if (data == MAP_FAILED) {
+            try {
+                readAll(fd, buffer.owned);
+            } catch (...) {
+                close(fd);
+                throw;
+            }
+        } else {
+            madvise(data, info.st_size, MADV_SEQUENTIAL);
+            buffer.mapped = data;
+            buffer.mappedSize = info.st_size;
+        }
+        close(fd);
+        return buffer;
+    }
+
+    // Разбор всех целых чисел из текста (разделители - любые нецифровые символы кроме '-').
+    // Число вне диапазона int - ошибка: модуль проверяется после каждого шага,
+    // поэтому и 20+ цифр не переполняют int64
+    static void parseInts(const char* p, const char* end, std::vector<int>& out) {
+        while (true) {
+            while (p < end && !isDigit(*p) && *p != '-') p++;
+            if (p >= end) return;
+
+            bool negative = false;
+            if (*p == '-') {
+                negative = true;
+                if (++p >= end || !isDigit(*p)) continue;
+            }
+
+            int64_t value = 0;
+            // По 8 цифр за раз, пока до конца буфера есть целое слово
+            while (end - p >= 8) {
+                uint64_t word;
+                std::memcpy(&word, p, 8);
+                int digits = leadingDigits(word);
+                if (digits == 0) break;
+                value = value * powersOf10[digits] + parseDigits(word, digits);
+                p += digits;
+                if (value > kIntMagnitude) throw std::runtime_error("Number out of int range");
+                if (digits < 8) break;
+            }
+            while (p < end && isDigit(*p)) {
+                value = value * 10 + (*p - '0');
+                p++;
+                if (value > kIntMagnitude) throw std::runtime_error("Number out of int range");
+            }
+            if (!negative && value == kIntMagnitude) throw std::runtime_error("Number out of int range");
+            out.push_back(static_cast<int>(negative ? -value : value));
+        }
+    }
+
+    // Формат "n, затем n чисел": лишние числа отбрасываются, недостающие - ошибка
+    static std::vector<int> parseCounted(const InputBuffer& input) {
+        std::vector<int> values;
+        values.reserve(input.size() / 4);
+        parseInts(input.begin(), input.end(), values);
+        if (values.empty()) {
+            return values;
+        }
+        long long n = values[0];
+        if (n < 0 || n > static_cast<long long>(values.size()) - 1) {
+            throw std::runtime_error("Input declares " + std::to_string(n) + " numbers but contains " +
+                                     std::to_string(values.size() - 1));
+        }
+        values.erase(values.begin());
+        values.resize(n);
+        return values;
+    }
+
+    // Сырые int32 в порядке байтов машины, без заголовка
+    static std::vector<int> parseBinary(const InputBuffer& input) {
+        if (input.size() % sizeof(int) != 0) {
+            throw std::runtime_error("Binary input size is not a multiple of 4 bytes");
+        }
+        std::vector<int> values(input.size() / sizeof(int));
+        std::memcpy(values.data(), input.begin(), input.size());
+        return values;
+    }
+
+    // Вывод чисел через разделитель в файл или stdout ("-" или пустой путь)
+    static void writeText(const std::string& path, const std::vector<int>& values, char separator = '\n') {
+        int fd = openOutput(path);
+        std::vector<char> buffer(kOutputBlock + 16);
+        size_t used = 0;
+        for (int value : values) {
+            if (used > kOutputBlock) {
+                writeAll(fd, buffer.data(), used);
+                used = 0;
+            }
+            used += formatInt(value, &buffer[used]);
+            buffer[used++] = separator;
+        }
+        writeAll(fd, buffer.data(), used);
+        closeOutput(fd);
+    }
+
+    static void writeBinary(const std::string& path, const std::vector<int>& values) {
+        int fd = openOutput(path);
+        writeAll(fd, reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int));
+        closeOutput(fd);
+    }
+
+    // Запись числа в out (нужно до 11 байт), возвращает длину
+    static size_t formatInt(int value, char* out) {
+        char* start = out;
+        uint32_t u = static_cast<uint32_t>(value);
+        if (value < 0) {
+            *out++ = '-';
+            u = 0u - u;
+        }
+        char digits[10];
+        char* d = digits + 10;
+        while (u >= 100) {
+            uint32_t pair = u % 100;
+            u /= 100;
+            d -= 2;
+            std::memcpy(d, &digitPairs()[pair * 2], 2);
+        }
+        if (u >= 10) {
+            d -= 2;
+            std::memcpy(d, &digitPairs()[u * 2], 2);
+        } else {
+            *--d = static_cast<char>('0' + u);
+        }
+        size_t length = digits + 10 - d;
+        std::memcpy(out, d, length);
+        return out + length - start;
+    }
+
+private:
+    static constexpr size_t kInputInitial = 1 << 16;
+    static constexpr int64_t kIntMagnitude = 1LL << 31; // |INT_MIN|
+    static constexpr size_t kOutputBlock = 1 << 20;
+    static constexpr int64_t powersOf10[9] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+    static bool isDigit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+
+    // Число подряд идущих цифр с начала слова (первый символ - младший байт).
+    // Байт - цифра, если его старшая тетрада 3 и после прибавления 6 она не меняется
+    static int leadingDigits(uint64_t word) {
+        const uint64_t high = 0xF0F0F0F0F0F0F0F0ULL;
+        const uint64_t threes = 0x3030303030303030ULL;
+        uint64_t bad = ((word & high) ^ threes) | (((word + 0x0606060606060606ULL) & high) ^ threes);
+        // Старший бит каждого ненулевого байта bad, без переносов между байтами
+        const uint64_t low7 = 0x7F7F7F7F7F7F7F7FULL;
+        uint64_t nonZero = (((bad & low7) + low7) | bad) & ~low7;
+        return nonZero ? __builtin_ctzll(nonZero) / 8 : 8;
+    }
+
+    // Значение первых digits (1..8) цифр слова: цифры сдвигаются в старшие байты,
+    // освободившиеся младшие байты играют роль ведущих нулей
+    static uint32_t parseDigits(uint64_t word, int digits) {
+        uint64_t value = (word & 0x0F0F0F0F0F0F0F0FULL) << (8 * (8 - digits));
+        value = (value * 10 + (value >> 8)) & 0x00FF00FF00FF00FFULL;
+        value = (value * 100 + (value >> 16)) & 0x0000FFFF0000FFFFULL;
+        value = (value * 10000 + (value >> 32)) & 0x00000000FFFFFFFFULL;
+        return static_cast<uint32_t>(value);
+    }
+
+    static const char* digitPairs() {
+        static const char table[201] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        return table;
+    }
+
+    // Буфер растет вдвое по мере чтения: маленький вход не платит за обнуление
+    // большого буфера, большой - копируется O(n) раз суммарно
+    static void readAll(int fd, std::vector<char>& out) {
+        size_t used = 0;
+        out.resize(kInputInitial);
+        while (true) {
+            if (used == out.size()) {
+                out.resize(out.size() * 2);
+            }
+            ssize_t got = read(fd, out.data() + used, out.size() - used);
+            if (got < 0) {
+                throw std::runtime_error("Input read failed");
+            }
+            if (got == 0) break;
+            used += got;
+        }
+        out.resize(used);
+    }
+
+    static int openOutput(const std::string& path) {
+        if (path.empty() || path == "-") {
+            return STDOUT_FILENO;
+        }
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open output file: " + path);
+        }
+        return fd;
+    }
+
+    static void closeOutput(int fd) {
+        if (fd != STDOUT_FILENO) {
+            close(fd);
+        }
+    }
+
+    static void writeAll(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t written = write(fd, data, size);
+            if (written < 0) {
+                throw std::runtime_error("Output write failed");
+            }
+            data += written;
+            size -= written;
+        }
+    }
+};
+
+#endif
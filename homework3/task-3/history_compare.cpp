@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "result_history.h"
+
+// Сравнение двух прогонов из истории замеров (result_history.h) и поиск регрессий.
+// Прогон задается RunId или префиксом коммита - тогда объединяются все прогоны этого
+// коммита (для драйверов с одним замером на размер, как SortingComparison, стоит
+// запустить драйвер несколько раз на каждом коммите).
+// Группа сравнения - (алгоритм, тип данных, размер, округленный вниз до степени двойки),
+// замер внутри группы - наносекунды на элемент: так свип task-2 с шагом 100 дает
+// десятки замеров на группу уже в одном прогоне.
+// В каждой группе - односторонний критерий Манна-Уитни (кандидат медленнее базы):
+// точное распределение на малых выборках без совпадений, иначе нормальное приближение
+// с поправкой на совпадения. p-значения по всем группам поправляются методом Холма,
+// отдельно для замедлений и для ускорений.
+// Регрессия: поправленное p < alpha и медиана выросла больше чем на threshold.
+// Запуск:
+//   ./HistoryCompare [--history file] [--driver name] [--alpha 0.01] [--threshold 0.05]
+//                    [--min-samples 5] [--all] [baseline candidate]
+//   ./HistoryCompare --list
+// Без baseline/candidate сравниваются два последних прогона драйвера последнего прогона.
+// Код возврата: 0 - регрессий нет, 1 - есть регрессии, 2 - ошибка или нечего сравнивать,
+// в том числе когда ни в одной группе нет min-samples замеров с каждой стороны
+// (ничего не проверено - это не "регрессий нет")
+
+using Record = ResultHistory::Record;
+
+struct RunInfo {
+    std::string runId;
+    std::string timestamp;
+    std::string commit;
+    std::string compiler;
+    std::string flags;
+    std::string cpu;
+    std::string driver;
+    size_t rows;
+};
+
+// Прогоны в порядке первого появления в истории
+std::vector<RunInfo> listRuns(const std::vector<Record>& records) {
+    std::vector<RunInfo> runs;
+    std::map<std::string, size_t> index;
+    for (const Record& r : records) {
+        auto it = index.find(r.runId);
+        if (it == index.end()) {
+            index[r.runId] = runs.size();
+            runs.push_back({r.runId, r.timestamp, r.commit, r.compiler, r.flags, r.cpu, r.driver, 1});
+        } else {
+            runs[it->second].rows++;
+        }
+    }
+    return runs;
+}
+
+// RunId целиком или префикс коммита; driver, если задан, ограничивает выбор
+std::set<std::string> selectRuns(const std::vector<RunInfo>& runs, const std::string& selector,
+                                 const std::string& driver) {
+    std::set<std::string> selected;
+    for (const RunInfo& run : runs) {
+        if (!driver.empty() && run.driver != driver) continue;
+        if (run.runId == selector) return {run.runId};
+        if (run.commit.compare(0, selector.size(), selector) == 0) selected.insert(run.runId);
+    }
+    return selected;
+}
+
+long long sizeBucket(long long size) {
+    long long bucket = 1;
+    while (bucket * 2 <= size) bucket *= 2;
+    return bucket;
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+// P(U >= наблюдаемого) для U кандидата: доля пар (кандидат, база), где кандидат медленнее
+double mannWhitneyGreater(const std::vector<double>& base, const std::vector<double>& candidate) {
+    const size_t n = candidate.size(), m = base.size(), total = n + m;
+    std::vector<std::pair<double, int>> all;
+    for (double v : candidate) all.push_back({v, 1});
+    for (double v : base) all.push_back({v, 0});
+    std::sort(all.begin(), all.end());
+
+    // Средние ранги для совпадений
+    double rankSum = 0, tieTerm = 0;
+    for (size_t i = 0; i < total;) {
+        size_t j = i;
+        while (j < total && all[j].first == all[i].first) j++;
+        double rank = (i + 1 + j) / 2.0;
+        for (size_t k = i; k < j; k++) {
+            if (all[k].second) rankSum += rank;
+        }
+        double t = static_cast<double>(j - i);
+        tieTerm += t * t * t - t;
+        i = j;
+    }
+
+    // Точное распределение суммы рангов: число n-подмножеств {1..total} с данной суммой
+    if (tieTerm == 0 && total <= 50) {
+        const size_t maxSum = total * (total + 1) / 2;
+        std::vector<std::vector<double>> ways(n + 1, std::vector<double>(maxSum + 1, 0));
+        ways[0][0] = 1;
+        for (size_t rank = 1; rank <= total; rank++) {
+            for (size_t k = std::min(rank, n); k >= 1; k--) {
+                for (size_t s = maxSum; s >= rank; s--) {
+                    ways[k][s] += ways[k - 1][s - rank];
+                }
+            }
+        }
+        double subsets = 0, tail = 0;
+        for (size_t s = 0; s <= maxSum; s++) {
+            subsets += ways[n][s];
+            if (s + 0.5 >= rankSum) tail += ways[n][s];
+        }
+        return tail / subsets;
+    }
+
+    double u = rankSum - n * (n + 1) / 2.0;
+    double mean = n * m / 2.0;
+    double variance = n * m / 12.0 * ((total + 1) - tieTerm / (static_cast<double>(total) * (total - 1)));
+    if (variance <= 0) return 1;
+    double z = (u - mean - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+struct Group {
+    std::vector<double> base;
+    std::vector<double> candidate;
+};
+
+struct Comparison {
+    std::string algorithm;
+    std::string pattern;
+    long long bucket;
+    size_t baseCount;
+    size_t candidateCount;
+    double baseMedian;
+    double candidateMedian;
+    double change;       // Относительное изменение медианы
+    double pSlower;      // Одностороннее p: кандидат медленнее (после поправки Холма)
+    double pFaster;      // Одностороннее p: кандидат быстрее (после поправки Холма)
+    bool tested;
+};
+
+// Поправка Холма на множественные сравнения: k-е по возрастанию p умножается на (m - k),
+// результат делается монотонным
+void holmAdjust(std::vector<double*>& pValues) {
+    std::sort(pValues.begin(), pValues.end(), [](const double* a, const double* b) { return *a < *b; });
+    double running = 0;
+    for (size_t k = 0; k < pValues.size(); k++) {
+        running = std::max(running, std::min(1.0, (pValues.size() - k) * *pValues[k]));
+        *pValues[k] = running;
+    }
+}
+
+void printRuns(const std::vector<RunInfo>& runs) {
+    std::cout << "RunId, Timestamp, Driver, Commit, Rows, Compiler, Flags, Cpu" << std::endl;
+    for (const RunInfo& run : runs) {
+        std::cout << run.runId << ", " << run.timestamp << ", " << run.driver << ", " << run.commit << ", "
+                  << run.rows << ", " << run.compiler << ", " << run.flags << ", " << run.cpu << std::endl;
+    }
+}
+
+void describeSide(const char* title, const std::vector<RunInfo>& runs, const std::set<std::string>& ids) {
+    std::cout << title << ":";
+    for (const RunInfo& run : runs) {
+        if (ids.count(run.runId)) {
+            std::cout << " " << run.runId << " (" << run.commit << ")";
+        }
+    }
+    std::cout << std::endl;
+}
+
+// Разные компилятор, флаги или процессор делают сравнение сомнительным - предупреждаем
+void checkComparable(const std::vector<RunInfo>& runs, const std::set<std::string>& base,
+                     const std::set<std::string>& candidate) {
+    std::set<std::string> compilers, flags, cpus;
+    for (const RunInfo& run : runs) {
+        if (base.count(run.runId) || candidate.count(run.runId)) {
+            compilers.insert(run.compiler);
+            flags.insert(run.flags);
+            cpus.insert(run.cpu);
+        }
+    }
+    if (compilers.size() > 1) std::cout << "WARNING: runs were built by different compilers" << std::endl;
+    if (flags.size() > 1) std::cout << "WARNING: runs were built with different flags" << std::endl;
+    if (cpus.size() > 1) std::cout << "WARNING: runs were measured on different CPUs" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::string historyPath = ResultHistory::path();
+    std::string driver;
+    double alpha = 0.01;
+    double threshold = 0.05;
+    size_t minSamples = 5;
+    bool showAll = false, list = false;
+    std::vector<std::string> selectors;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--history" && hasValue) historyPath = argv[++i];
+        else if (arg == "--driver" && hasValue) driver = argv[++i];
+        else if (arg == "--alpha" && hasValue) alpha = std::atof(argv[++i]);
+        else if (arg == "--threshold" && hasValue) threshold = std::atof(argv[++i]);
+        else if (arg == "--min-samples" && hasValue) minSamples = std::max(2, std::atoi(argv[++i]));
+        else if (arg == "--all") showAll = true;
+        else if (arg == "--list") list = true;
+        else if (arg.compare(0, 2, "--") != 0) selectors.push_back(arg);
+        else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<Record> records = ResultHistory::load(historyPath);
+    std::vector<RunInfo> runs = listRuns(records);
+    if (runs.empty()) {
+        std::cerr << "No runs in history: " << historyPath << std::endl;
+        return 2;
+    }
+    if (list) {
+        printRuns(runs);
+        return 0;
+    }
+
+    std::set<std::string> baseRuns, candidateRuns;
+    if (selectors.empty()) {
+        if (driver.empty()) driver = runs.back().driver;
+        std::vector<std::string> ids;
+        for (const RunInfo& run : runs) {
+            if (run.driver == driver) ids.push_back(run.runId);
+        }
+        if (ids.size() < 2) {
+            std::cerr << "Need two runs of driver '" << driver << "' in " << historyPath << std::endl;
+            return 2;
+        }
+        baseRuns = {ids[ids.size() - 2]};
+        candidateRuns = {ids.back()};
+    } else if (selectors.size() == 2) {
+        baseRuns = selectRuns(runs, selectors[0], driver);
+        candidateRuns = selectRuns(runs, selectors[1], driver);
+    } else {
+        std::cerr << "Expected two runs (RunId or commit prefix): baseline candidate" << std::endl;
+        return 2;
+    }
+    if (baseRuns.empty() || candidateRuns.empty()) {
+        std::cerr << "No runs match " << (baseRuns.empty() ? selectors[0] : selectors[1]) << std::endl;
+        return 2;
+    }
+    for (const std::string& id : baseRuns) {
+        if (candidateRuns.count(id)) {
+            std::cerr << "Baseline and candidate share run " << id << std::endl;
+            return 2;
+        }
+    }
+
+    std::cout << "History: " << historyPath << std::endl;
+    describeSide("Baseline", runs, baseRuns);
+    describeSide("Candidate", runs, candidateRuns);
+    checkComparable(runs, baseRuns, candidateRuns);
+
+    std::map<std::tuple<std::string, std::string, long long>, Group> groups;
+    for (const Record& r : records) {
+        bool isBase = baseRuns.count(r.runId) > 0;
+        if (!isBase && !candidateRuns.count(r.runId)) continue;
+        Group& group = groups[std::make_tuple(r.algorithm, r.pattern, sizeBucket(r.size))];
+        (isBase ? group.base : group.candidate).push_back(r.timeNs / r.size);
+    }
+
+    std::vector<Comparison> comparisons;
+    for (const auto& entry : groups) {
+        const Group& group = entry.second;
+        Comparison c{std::get<0>(entry.first), std::get<1>(entry.first), std::get<2>(entry.first),
+                     group.base.size(), group.candidate.size(), 0, 0, 0, 1, 1, false};
+        if (group.base.empty() || group.candidate.empty()) continue; // Есть только в одном прогоне
+        c.baseMedian = median(group.base);
+        c.candidateMedian = median(group.candidate);
+        c.change = c.baseMedian > 0 ? c.candidateMedian / c.baseMedian - 1 : 0;
+        if (c.baseCount >= minSamples && c.candidateCount >= minSamples) {
+            c.tested = true;
+            c.pSlower = mannWhitneyGreater(group.base, group.candidate);
+            c.pFaster = mannWhitneyGreater(group.candidate, group.base);
+        }
+        comparisons.push_back(c);
+    }
+
+    std::vector<double*> slower, faster;
+    for (Comparison& c : comparisons) {
+        if (!c.tested) continue;
+        slower.push_back(&c.pSlower);
+        faster.push_back(&c.pFaster);
+    }
+    holmAdjust(slower);
+    holmAdjust(faster);
+
+    size_t regressions = 0, improvements = 0, untested = 0;
+    std::cout << std::endl << std::left << std::setw(22) << "Algorithm" << std::setw(15) << "Pattern"
+              << std::setw(16) << "Sizes" << std::setw(10) << "Samples" << std::setw(12) << "Base ns/el"
+              << std::setw(12) << "Cand ns/el" << std::setw(10) << "Change" << std::setw(11) << "p (Holm)"
+              << "Verdict" << std::endl;
+    for (const Comparison& c : comparisons) {
+        std::string verdict = "ok";
+        if (!c.tested) {
+            verdict = "few samples";
+            untested++;
+        } else if (c.pSlower < alpha && c.change > threshold) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (c.pFaster < alpha && c.change < -threshold) {
+            verdict = "faster";
+            improvements++;
+        }
+        if (!showAll && verdict != "REGRESSION" && verdict != "faster") continue;
+
+        std::string sizes = "[" + std::to_string(c.bucket) + ", " + std::to_string(c.bucket * 2) + ")";
+        std::string samples = std::to_string(c.baseCount) + "/" + std::to_string(c.candidateCount);
+        std::cout << std::setw(22) << c.algorithm << std::setw(15) << c.pattern << std::setw(16) << sizes
+                  << std::setw(10) << samples << std::fixed << std::setprecision(3) << std::setw(12)
+                  << c.baseMedian << std::setw(12) << c.candidateMedian << std::showpos << std::setprecision(1)
+                  << std::setw(10) << c.change * 100 << std::noshowpos << std::setprecision(4) << std::setw(11);
+        if (c.tested) std::cout << (c.change > 0 ? c.pSlower : c.pFaster);
+        else std::cout << "-";
+        std::cout << verdict << std::defaultfloat << std::endl;
+    }
+
+    std::cout << std::endl << comparisons.size() << " groups: " << regressions << " regressions, " << improvements
+              << " faster, " << untested << " with fewer than " << minSamples << " samples per side"
+              << " (alpha " << alpha << ", threshold " << threshold * 100 << "%)" << std::endl;
+    if (slower.empty()) {
+        std::cerr << "NOT TESTED: no group has " << minSamples << " samples on both sides. "
+                  << "Combine several runs per side (commit prefix) or lower --min-samples" << std::endl;
+        return 2;
+    }
+    return regressions > 0 ? 1 : 0;
+}
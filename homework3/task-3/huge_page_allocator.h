@@ -0,0 +1,234 @@
+#ifndef HUGE_PAGE_ALLOCATOR_H
+#define HUGE_PAGE_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Буферы для сортировки очень больших массивов (10^8 и больше элементов).
+// На обычных страницах по 4 КБ такие массивы не помещаются в TLB, а вспомогательные
+// массивы mergeSort каждый раз заново получают память и страницы от ядра.
+//  - TRANSPARENT: mmap, выровненный на 2 МБ, + madvise(MADV_HUGEPAGE);
+//  - EXPLICIT: mmap(MAP_HUGETLB) из зарезервированных страниц (vm.nr_hugepages),
+//    при их нехватке - как TRANSPARENT;
+//  - страницы сразу же трогает выделяющий поток (first touch): ядро размещает их
+//    на узле NUMA этого потока, поэтому выделять стоит в том же (привязанном) потоке,
+//    что будет сортировать;
+//  - освобожденные буферы не возвращаются ядру, а ждут следующего выделения
+//    того же размера, в том же режиме и на том же узле NUMA: буфер TRANSPARENT
+//    не выдается под запрос EXPLICIT и наоборот, а страницы, размещенные на другом
+//    узле, не переезжают - такой буфер не берется из кэша.
+// Блоки меньше 2 МБ выделяются обычным operator new.
+class HugePagePool {
+public:
+    enum Mode {
+        TRANSPARENT,
+        EXPLICIT
+    };
+
+    static constexpr size_t kHugePage = 2 * 1024 * 1024;
+
+    struct Stats {
+        size_t mapped;        // Новых отображений
+        size_t reused;        // Выделений из кэша
+        size_t explicitPages; // Отображений на зарезервированных страницах
+    };
+
+    static void* allocate(size_t bytes, Mode mode) {
+        if (bytes < kHugePage) {
+            return ::operator new(bytes);
+        }
+        size_t rounded = roundUp(bytes);
+        Pool& pool = instance();
+        const unsigned node = currentNode();
+        {
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            for (size_t i = 0; i < pool.cached.size(); i++) {
+                const Block& block = pool.cached[i];
+                if (block.bytes == rounded && block.mode == mode && block.node == node) {
+                    void* p = pool.cached[i].pointer;
+                    pool.cached[i] = pool.cached.back();
+                    pool.cached.pop_back();
+                    pool.stats.reused++;
+                    return p;
+                }
+            }
+        }
+
+        void* p = MAP_FAILED;
+        if (mode == EXPLICIT) {
+            p = mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+        bool explicitPages = p != MAP_FAILED;
+        if (!explicitPages) {
+            p = mapAligned(rounded);
+        }
+        firstTouch(p, rounded);
+
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.stats.mapped++;
+        pool.stats.explicitPages += explicitPages;
+        return p;
+    }
+
+    // mode - тот же, что при выделении
+    static void release(void* p, size_t bytes, Mode mode) {
+        if (bytes < kHugePage) {
+            ::operator delete(p);
+            return;
+        }
+        size_t rounded = roundUp(bytes);
+        Pool& pool = instance();
+        const unsigned node = pageNode(p);
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (pool.cached.size() < kMaxCached) {
+            pool.cached.push_back({p, rounded, mode, node});
+        } else {
+            munmap(p, rounded);
+        }
+    }
+
+    // Вернуть все кэшированные буферы ядру
+    static void trim() {
+        Pool& pool = instance();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        for (const Block& block : pool.cached) {
+            munmap(block.pointer, block.bytes);
+        }
+        pool.cached.clear();
+    }
+
+    static Stats stats() {
+        Pool& pool = instance();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        return pool.stats;
+    }
+
+private:
+    static constexpr size_t kMaxCached = 8;
+
+    struct Block {
+        void* pointer;
+        size_t bytes;
+        Mode mode;     // Режим запроса, под который блок был выделен
+        unsigned node; // Узел NUMA, на котором размещены его страницы
+    };
+
+    struct Pool {
+        std::mutex mutex;
+        std::vector<Block> cached;
+        Stats stats = {0, 0, 0};
+
+        ~Pool() {
+            for (const Block& block : cached) {
+                munmap(block.pointer, block.bytes);
+            }
+        }
+    };
+
+    static Pool& instance() {
+        static Pool pool;
+        return pool;
+    }
+
+    static unsigned currentNode() {
+        unsigned cpu = 0, node = 0;
+#if defined(SYS_getcpu)
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+            node = 0;
+        }
+#endif
+        return node;
+    }
+
+    // Узел NUMA, на котором лежит страница p (get_mempolicy без libnuma);
+    // если ядро не отвечает - узел текущего потока
+    static unsigned pageNode(void* p) {
+#if defined(SYS_get_mempolicy)
+        const unsigned long kPolicyNode = 1, kPolicyAddress = 2; // MPOL_F_NODE, MPOL_F_ADDR
+        int node = -1;
+        if (syscall(SYS_get_mempolicy, &node, nullptr, 0UL, p, kPolicyNode | kPolicyAddress) == 0 && node >= 0) {
+            return static_cast<unsigned>(node);
+        }
+#endif
+        return currentNode();
+    }
+
+    static size_t roundUp(size_t bytes) {
+        return (bytes + kHugePage - 1) / kHugePage * kHugePage;
+    }
+
+    // Отображение с запасом в одну большую страницу, лишние края отрезаются,
+    // чтобы ядро могло подложить страницы по 2 МБ
+    static void* mapAligned(size_t bytes) {
+        void* raw = mmap(nullptr, bytes + kHugePage, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t aligned = (start + kHugePage - 1) & ~(kHugePage - 1);
+        if (aligned > start) {
+            munmap(raw, aligned - start);
+        }
+        uintptr_t tail = aligned + bytes;
+        uintptr_t end = start + bytes + kHugePage;
+        if (end > tail) {
+            munmap(reinterpret_cast<void*>(tail), end - tail);
+        }
+        void* p = reinterpret_cast<void*>(aligned);
+        madvise(p, bytes, MADV_HUGEPAGE);
+        return p;
+    }
+
+    static void firstTouch(void* p, size_t bytes) {
+        volatile char* bytesPointer = static_cast<char*>(p);
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        for (size_t offset = 0; offset < bytes; offset += page) {
+            bytesPointer[offset] = 0;
+        }
+    }
+};
+
+// Аллокатор для std::vector поверх HugePagePool. Режим - параметр шаблона,
+// поэтому аллокатор без состояния и все его экземпляры взаимозаменяемы
+template <typename T, HugePagePool::Mode Mode = HugePagePool::TRANSPARENT>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = HugePageAllocator<U, Mode>;
+    };
+
+    HugePageAllocator() = default;
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U, Mode>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(HugePagePool::allocate(n * sizeof(T), Mode));
+    }
+
+    void deallocate(T* p, size_t n) {
+        HugePagePool::release(p, n * sizeof(T), Mode);
+    }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U, Mode>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U, Mode>&) const { return false; }
+};
+
+template <typename T, HugePagePool::Mode Mode = HugePagePool::TRANSPARENT>
+using HugePageVector = std::vector<T, HugePageAllocator<T, Mode>>;
+
+#endif
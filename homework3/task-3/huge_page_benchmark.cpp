@@ -0,0 +1,162 @@
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "background_worker.h"
+#include "data_generator.h"
+#include "huge_page_allocator.h"
+#include "sort_algorithms.h"
+
+// Сортировка больших массивов на обычных страницах и на страницах по 2 МБ:
+// время и промахи dTLB (perf_event_open) для входа и вспомогательных буферов.
+// Запуск: ./HugePageBenchmark [maxSize], по умолчанию 10^7 (10^8 - около 1.2 ГБ памяти)
+
+// Счетчик промахов dTLB на чтение для текущего потока, только пользовательский режим.
+// Если perf недоступен (виртуальная машина, perf_event_paranoid), available() == false
+class DtlbMissCounter {
+public:
+    DtlbMissCounter() {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    ~DtlbMissCounter() {
+        if (fd >= 0) close(fd);
+    }
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    long long stop() {
+        if (fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long value = 0;
+        if (read(fd, &value, sizeof(value)) != sizeof(value)) return -1;
+        return value;
+    }
+
+private:
+    int fd;
+};
+
+struct Measurement {
+    double timeMs;
+    long long dtlbMisses;
+    bool correct;
+};
+
+// Лучшее из runs запусков. Вектор под вход выделяется один раз и переиспользуется,
+// вспомогательные буферы сортировок на больших страницах возвращаются в пул
+template <typename Vector, typename SortFunction>
+Measurement measure(const std::vector<int>& original, SortFunction sortFunc, DtlbMissCounter& counter, int runs) {
+    Vector data(original.size());
+    Measurement best = {1e18, -1, true};
+    for (int run = 0; run < runs; run++) {
+        std::copy(original.begin(), original.end(), data.begin());
+        counter.start();
+        auto start = std::chrono::steady_clock::now();
+        sortFunc(data);
+        auto end = std::chrono::steady_clock::now();
+        long long misses = counter.stop();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (ms < best.timeMs) {
+            best.timeMs = ms;
+            best.dtlbMisses = misses;
+        }
+        best.correct = best.correct && std::is_sorted(data.begin(), data.end());
+    }
+    return best;
+}
+
+template <typename Vector>
+void benchmarkLayout(const std::vector<int>& original, DtlbMissCounter& counter,
+                     std::vector<Measurement>& row) {
+    const int runs = 3;
+    row.push_back(measure<Vector>(original, [](Vector& v) { SortAlgorithms::mergeSort(v); }, counter, runs));
+    row.push_back(measure<Vector>(original, [](Vector& v) { SortAlgorithms::radixSort(v); }, counter, runs));
+    row.push_back(measure<Vector>(original, [](Vector& v) { SortAlgorithms::quickSortHybrid(v); }, counter, runs));
+}
+
+int main(int argc, char** argv) {
+    long long maxSize = argc > 1 ? std::atoll(argv[1]) : 10000000;
+
+    // First touch: буферы размещаются на узле NUMA потока, который их выделил и сортирует
+    int core = BackgroundWorker::measurementCore();
+    if (core >= 0) {
+        BackgroundWorker::pinCurrentThread(core);
+    }
+    unsigned cpu = 0, node = 0;
+    syscall(SYS_getcpu, &cpu, &node, nullptr);
+
+    DtlbMissCounter counter;
+    std::cout << "=== HUGE PAGES: 4KB pages vs 2MB pages (cpu " << cpu << ", NUMA node " << node << ") ===" << std::endl;
+    if (!counter.available()) {
+        std::cout << "dTLB counter is unavailable (perf_event_open failed), misses are reported as -1" << std::endl;
+    }
+
+    const char* algorithms[] = {"MergeSort", "RadixSort", "QuickSort_Hybrid"};
+    const char* layouts[] = {"4KB", "THP_2MB", "HugeTLB_2MB"};
+
+    std::ofstream csv("huge_page_results.csv");
+    csv << "Algorithm,Layout,Size,TimeMs,DtlbMisses,Correct\n";
+
+    for (long long size = 1000000; size <= maxSize; size *= 10) {
+        std::vector<int> original = DataGenerator::generateData(static_cast<int>(size), DataGenerator::RANDOM);
+        std::vector<std::vector<Measurement>> results(3);
+        // Пул очищается после каждой раскладки: каждая начинает со своих новых отображений
+        benchmarkLayout<std::vector<int>>(original, counter, results[0]);
+        benchmarkLayout<HugePageVector<int, HugePagePool::TRANSPARENT>>(original, counter, results[1]);
+        HugePagePool::trim();
+        benchmarkLayout<HugePageVector<int, HugePagePool::EXPLICIT>>(original, counter, results[2]);
+        HugePagePool::trim();
+
+        std::cout << "Size: " << size << std::endl;
+        for (int a = 0; a < 3; a++) {
+            const Measurement& base = results[0][a];
+            std::cout << "  " << algorithms[a] << ":";
+            for (int l = 0; l < 3; l++) {
+                const Measurement& m = results[l][a];
+                std::cout << " " << layouts[l] << "=" << m.timeMs << "ms";
+                if (l > 0) {
+                    std::cout << " (" << (m.timeMs - base.timeMs) / base.timeMs * 100 << "%";
+                    if (m.dtlbMisses >= 0 && base.dtlbMisses > 0) {
+                        std::cout << ", dTLB " << m.dtlbMisses - base.dtlbMisses;
+                    }
+                    std::cout << ")";
+                } else if (m.dtlbMisses >= 0) {
+                    std::cout << " (dTLB " << m.dtlbMisses << ")";
+                }
+                std::cout << (m.correct ? "" : " FAIL");
+                csv << algorithms[a] << "," << layouts[l] << "," << size << "," << m.timeMs << ","
+                    << m.dtlbMisses << "," << (m.correct ? "true" : "false") << "\n";
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    HugePagePool::Stats stats = HugePagePool::stats();
+    std::cout << "Huge page pool: " << stats.mapped << " mappings (" << stats.explicitPages
+              << " on reserved HugeTLB pages), " << stats.reused << " buffers reused" << std::endl;
+    std::cout << "Results saved to 'huge_page_results.csv'" << std::endl;
+    return 0;
+}
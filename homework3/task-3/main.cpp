@@ -21,6 +21,7 @@ void runPerformanceAnalysis() {
     
     // Сохранение результатов
     tester.saveResultsToCSV("sorting_performance_results.csv");
+    tester.saveResultsToHistory("SortingComparison");
     
     // Вывод сводки
     tester.printSummary();
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "data_generator.h"
+#include "result_history.h"
+#include "sort_policies.h"
+
+// Перебор всех сочетаний политик из sort_policies.h на всех типах данных DataGenerator:
+// какая сборка быстрее всего на наших данных. Каждое сочетание - отдельная
+// инстанциация шаблона, список собирается во время компиляции.
+// Запуск: ./PolicySortBenchmark [size], по умолчанию 2^17.
+// Результаты: policy_sort_results.csv и общая история замеров (result_history.h),
+// в консоли - лучшие сборки по каждому типу и в сумме
+
+using SortFunction = void (*)(std::vector<int>&);
+
+struct Variant {
+    std::string name;
+    SortFunction sort;
+};
+
+template <typename... Ts>
+struct TypeList {};
+
+template <int... Values>
+struct IntList {};
+
+using Pivots = TypeList<RandomPivot, MedianOfThreePivot, NintherPivot>;
+using Partitions = TypeList<LomutoPartition, HoarePartition, ThreeWayPartition>;
+using BaseCases = TypeList<InsertionBase, NetworkBase>;
+using Fallbacks = TypeList<HeapFallback, NoFallback>;
+using Cutoffs = IntList<8, 16, 32, 64>;
+
+template <typename Sort>
+void addVariant(std::vector<Variant>& variants) {
+    variants.push_back({Sort::name(), [](std::vector<int>& arr) { Sort::sort(arr); }});
+}
+
+// Раскрытие декартова произведения: каждый уровень фиксирует одну политику
+template <typename Pivot, typename Partition, typename BaseCase, typename Fallback, int... Cs>
+void addCutoffs(std::vector<Variant>& variants, IntList<Cs...>) {
+    (addVariant<PolicyQuickSort<Pivot, Partition, BaseCase, Cs, Fallback>>(variants), ...);
+}
+
+template <typename Pivot, typename Partition, typename BaseCase, typename... Fs>
+void addFallbacks(std::vector<Variant>& variants, TypeList<Fs...>) {
+    (addCutoffs<Pivot, Partition, BaseCase, Fs>(variants, Cutoffs()), ...);
+}
+
+template <typename Pivot, typename Partition, typename... Bs>
+void addBaseCases(std::vector<Variant>& variants, TypeList<Bs...>) {
+    (addFallbacks<Pivot, Partition, Bs>(variants, Fallbacks()), ...);
+}
+
+template <typename Pivot, typename... Ps>
+void addPartitions(std::vector<Variant>& variants, TypeList<Ps...>) {
+    (addBaseCases<Pivot, Ps>(variants, BaseCases()), ...);
+}
+
+template <typename... Ps>
+void addPivots(std::vector<Variant>& variants, TypeList<Ps...>) {
+    (addPartitions<Ps>(variants, Partitions()), ...);
+}
+
+template <typename BaseCase, int... Cs>
+void addMergeSorts(std::vector<Variant>& variants, IntList<Cs...>) {
+    (addVariant<PolicyMergeSort<BaseCase, Cs>>(variants), ...);
+}
+
+template <typename... Bs>
+void addMergeBaseCases(std::vector<Variant>& variants, TypeList<Bs...>) {
+    (addMergeSorts<Bs>(variants, Cutoffs()), ...);
+}
+
+// Лучшее из runs запусков. Если первый запуск в 20 раз медленнее std::sort
+// (квадратичный случай), остальные не делаются. correct сбрасывается любым неверным запуском
+double measureMs(const std::vector<int>& original, SortFunction sort, double referenceMs, int runs, bool& correct) {
+    std::vector<int> data;
+    double best = 1e18;
+    for (int run = 0; run < runs; run++) {
+        data = original;
+        auto start = std::chrono::steady_clock::now();
+        sort(data);
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+        correct = correct && std::is_sorted(data.begin(), data.end());
+        if (referenceMs > 0 && best > 20 * referenceMs) break;
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    int size = argc > 1 ? std::atoi(argv[1]) : 1 << 17;
+    const int runs = 3;
+
+    std::vector<Variant> variants;
+    addPivots(variants, Pivots());
+    addMergeBaseCases(variants, BaseCases());
+
+    const DataGenerator::DataType dataTypes[] = {
+        DataGenerator::RANDOM, DataGenerator::SORTED, DataGenerator::REVERSED,
+        DataGenerator::NEARLY_SORTED, DataGenerator::FEW_UNIQUE
+    };
+    const char* dataTypeNames[] = {"RANDOM", "SORTED", "REVERSED", "NEARLY_SORTED", "FEW_UNIQUE"};
+
+    std::cout << "=== POLICY MATRIX: " << variants.size() << " builds, size " << size << " ===" << std::endl;
+
+    ResultHistory history("PolicySortBenchmark");
+    std::ofstream csv("policy_sort_results.csv");
+    csv << "Variant,DataType,Size,TimeMs,RelativeToStdSort,Correct\n";
+
+    // Сумма отношений к std::sort по всем типам - общий рейтинг
+    std::map<std::string, double> totalRatio;
+    for (int t = 0; t < 5; t++) {
+        std::vector<int> original = DataGenerator::generateData(size, dataTypes[t]);
+        bool referenceCorrect = true;
+        double referenceMs = measureMs(original, [](std::vector<int>& arr) { std::sort(arr.begin(), arr.end()); },
+                                       0, runs, referenceCorrect);
+        history.add("std::sort", dataTypeNames[t], size, referenceMs * 1e6);
+
+        std::vector<std::pair<double, std::string>> ranking;
+        for (const Variant& variant : variants) {
+            bool correct = true;
+            double ms = measureMs(original, variant.sort, referenceMs, runs, correct);
+            double ratio = ms / referenceMs;
+            csv << variant.name << "," << dataTypeNames[t] << "," << size << "," << ms << "," << ratio << ","
+                << (correct ? "true" : "false") << "\n";
+            history.add(variant.name, dataTypeNames[t], size, ms * 1e6);
+            if (!correct) {
+                std::cout << "  " << variant.name << ": FAIL" << std::endl;
+            }
+            ranking.push_back({ms, variant.name});
+            totalRatio[variant.name] += ratio;
+        }
+        std::sort(ranking.begin(), ranking.end());
+
+        std::cout << dataTypeNames[t] << " (std::sort " << referenceMs << "ms):" << std::endl;
+        for (size_t i = 0; i < 3 && i < ranking.size(); i++) {
+            std::cout << "  " << i + 1 << ". " << ranking[i].second << " " << ranking[i].first << "ms" << std::endl;
+        }
+        std::cout << "  slowest: " << ranking.back().second << " " << ranking.back().first << "ms" << std::endl;
+    }
+
+    std::vector<std::pair<double, std::string>> overall;
+    for (const auto& entry : totalRatio) {
+        overall.push_back({entry.second / 5, entry.first});
+    }
+    std::sort(overall.begin(), overall.end());
+    std::cout << "Best overall (mean time relative to std::sort):" << std::endl;
+    for (size_t i = 0; i < 5 && i < overall.size(); i++) {
+        std::cout << "  " << i + 1 << ". " << overall[i].second << " x" << overall[i].first << std::endl;
+    }
+    std::cout << "Results saved to 'policy_sort_results.csv'" << std::endl;
+    history.save();
+    return 0;
+}
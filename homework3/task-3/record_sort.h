@@ -0,0 +1,164 @@
+#ifndef RECORD_SORT_H
+#define RECORD_SORT_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Сортировка "широких" записей по int-ключу.
+// Вместо перемещения целых записей на каждом обмене сортируются 64-битные слова
+// (ключ, индекс), а записи переставляются один раз в конце.
+class RecordSort {
+public:
+    enum Mode {
+        CYCLES, // Перестановка на месте по циклам: O(1) доп. памяти на запись
+        GATHER, // Сборка в новый буфер блоками с предвыборкой: нужна копия массива
+        AUTO    // GATHER для коротких записей, CYCLES для длинных (по замерам
+                // record_sort_benchmark: на 64+ байтах свежий буфер дороже циклов)
+    };
+
+    // Слово = ключ в старших 32 битах (со сдвигом знака), payload - в младших.
+    // Порядок слов как unsigned совпадает с порядком ключей как signed int
+    static uint64_t pack(int key, uint32_t payload) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(key) ^ 0x80000000u) << 32) | payload;
+    }
+
+    static int unpackKey(uint64_t word) {
+        return static_cast<int>(static_cast<uint32_t>(word >> 32) ^ 0x80000000u);
+    }
+
+    static uint32_t unpackPayload(uint64_t word) {
+        return static_cast<uint32_t>(word);
+    }
+
+    // Устойчивая LSD-сортировка упакованных слов по ключу (4 прохода по 8 бит).
+    // Проходы, где у всех слов одинаковая цифра, пропускаются
+    static void sortPacked(std::vector<uint64_t>& words) {
+        const size_t n = words.size();
+        if (n <= 1) return;
+
+        size_t counts[4][256] = {};
+        for (uint64_t w : words) {
+            for (int pass = 0; pass < 4; pass++) {
+                counts[pass][(w >> (32 + 8 * pass)) & 0xFF]++;
+            }
+        }
+
+        std::vector<uint64_t> buffer(n);
+        uint64_t* from = words.data();
+        uint64_t* to = buffer.data();
+        for (int pass = 0; pass < 4; pass++) {
+            size_t* count = counts[pass];
+            if (count[(from[0] >> (32 + 8 * pass)) & 0xFF] == n) {
+                continue;
+            }
+            size_t offset = 0;
+            for (int digit = 0; digit < 256; digit++) {
+                size_t c = count[digit];
+                count[digit] = offset;
+                offset += c;
+            }
+            for (size_t i = 0; i < n; i++) {
+                to[count[(from[i] >> (32 + 8 * pass)) & 0xFF]++] = from[i];
+            }
+            std::swap(from, to);
+        }
+        if (from != words.data()) {
+            words.swap(buffer);
+        }
+    }
+
+    // Перестановка сортировки: perm[i] - индекс записи, которая встанет на место i.
+    // Устойчива: записи с равными ключами сохраняют исходный порядок
+    template <typename Record, typename KeyFunction>
+    static std::vector<uint32_t> sortedPermutation(const std::vector<Record>& records, KeyFunction key) {
+        std::vector<uint64_t> words(records.size());
+        for (size_t i = 0; i < records.size(); i++) {
+            words[i] = pack(key(records[i]), static_cast<uint32_t>(i));
+        }
+        return permutationOf(words);
+    }
+
+    // result[i] = records[perm[i]] на месте: каждый цикл перестановки обходится один раз,
+    // каждая запись перемещается ровно один раз (плюс одна на цикл во временную)
+    template <typename Record>
+    static void applyPermutation(std::vector<Record>& records, std::vector<uint32_t> perm) {
+        const uint32_t done = UINT32_MAX;
+        for (size_t start = 0; start < perm.size(); start++) {
+            if (perm[start] == done || perm[start] == start) continue;
+            Record temp = std::move(records[start]);
+            size_t current = start;
+            while (perm[current] != start) {
+                size_t next = perm[current];
+                records[current] = std::move(records[next]);
+                perm[current] = done;
+                current = next;
+            }
+            records[current] = std::move(temp);
+            perm[current] = done;
+        }
+    }
+
+    // result[i] = records[perm[i]] через новый буфер. Источники следующего блока
+    // запрашиваются заранее, пока копируется текущий
+    template <typename Record>
+    static void gatherPermutation(std::vector<Record>& records, const std::vector<uint32_t>& perm) {
+        const size_t n = perm.size();
+        const size_t block = 16;
+        std::vector<Record> result;
+        result.reserve(n);
+        for (size_t begin = 0; begin < n; begin += block) {
+            size_t end = begin + block < n ? begin + block : n;
+            size_t ahead = end + block < n ? end + block : n;
+            for (size_t i = end; i < ahead; i++) {
+                __builtin_prefetch(&records[perm[i]]);
+            }
+            for (size_t i = begin; i < end; i++) {
+                result.push_back(std::move(records[perm[i]]));
+            }
+        }
+        records.swap(result);
+    }
+
+    // Устойчивая сортировка записей по ключу без перемещений на каждом шаге
+    template <typename Record, typename KeyFunction>
+    static void sortRecords(std::vector<Record>& records, KeyFunction key, Mode mode = AUTO) {
+        std::vector<uint32_t> perm = sortedPermutation(records, key);
+        if (mode == AUTO) {
+            mode = sizeof(Record) <= 32 ? GATHER : CYCLES;
+        }
+        if (mode == CYCLES) {
+            applyPermutation(records, std::move(perm));
+        } else {
+            gatherPermutation(records, perm);
+        }
+    }
+
+    // Структура массивов: ключи и любое число столбцов той же длины
+    // переставляются одной и той же перестановкой
+    template <typename... Columns>
+    static void sortColumns(std::vector<int>& keys, Columns&... columns) {
+        std::vector<uint64_t> words(keys.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            words[i] = pack(keys[i], static_cast<uint32_t>(i));
+        }
+        std::vector<uint32_t> perm = permutationOf(words);
+        for (size_t i = 0; i < keys.size(); i++) {
+            keys[i] = unpackKey(words[i]);
+        }
+        (gatherPermutation(columns, perm), ...);
+    }
+
+private:
+    // Отсортировать слова и достать из них индексы
+    static std::vector<uint32_t> permutationOf(std::vector<uint64_t>& words) {
+        sortPacked(words);
+        std::vector<uint32_t> perm(words.size());
+        for (size_t i = 0; i < words.size(); i++) {
+            perm[i] = unpackPayload(words[i]);
+        }
+        return perm;
+    }
+};
+
+#endif
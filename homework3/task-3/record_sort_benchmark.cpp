@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "data_generator.h"
+#include "record_sort.h"
+#include "result_history.h"
+
+// Запись заданного размера: int-ключ и "полезная нагрузка".
+// В начале payload - исходный индекс записи: по нему видны и потерянные payload, и нарушение устойчивости
+template <int Bytes>
+struct Record {
+    int key;
+    char payload[Bytes - sizeof(int)];
+};
+
+template <typename Func>
+double measureMs(Func func) {
+    auto start = std::chrono::high_resolution_clock::now();
+    func();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Устойчивые варианты должны совпасть с эталоном std::stable_sort байт в байт,
+// у std::sort порядок равных ключей не определен - сверяются только ключи
+template <typename Rec>
+bool sameRecords(const std::vector<Rec>& records, const std::vector<Rec>& reference, bool stable) {
+    if (records.size() != reference.size()) return false;
+    for (size_t i = 0; i < records.size(); i++) {
+        if (stable ? std::memcmp(&records[i], &reference[i], sizeof(Rec)) != 0 : records[i].key != reference[i].key) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int Bytes>
+void benchmarkRecords(const std::vector<int>& keys, std::ofstream& csv, ResultHistory& history) {
+    using Rec = Record<Bytes>;
+    std::vector<Rec> original(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        original[i].key = keys[i];
+        std::fill(std::begin(original[i].payload), std::end(original[i].payload), char(i));
+        uint32_t index = static_cast<uint32_t>(i);
+        std::memcpy(original[i].payload, &index, sizeof(index));
+    }
+    auto byKey = [](const Rec& r) { return r.key; };
+    auto keyLess = [](const Rec& a, const Rec& b) { return a.key < b.key; };
+
+    std::vector<Rec> reference = original;
+    std::stable_sort(reference.begin(), reference.end(), keyLess);
+
+    struct Variant {
+        std::string name;
+        double timeMs;
+        bool correct;
+    };
+    std::vector<Variant> variants;
+
+    std::vector<Rec> data = original;
+    double t = measureMs([&] {
+        std::sort(data.begin(), data.end(), keyLess);
+    });
+    variants.push_back({"std::sort", t, sameRecords(data, reference, false)});
+
+    data = original;
+    t = measureMs([&] { RecordSort::sortRecords(data, byKey, RecordSort::CYCLES); });
+    variants.push_back({"Indirect_Cycles", t, sameRecords(data, reference, true)});
+
+    data = original;
+    t = measureMs([&] { RecordSort::sortRecords(data, byKey, RecordSort::GATHER); });
+    variants.push_back({"Indirect_Gather", t, sameRecords(data, reference, true)});
+
+    std::cout << "  " << Bytes << "-byte records:";
+    for (const Variant& v : variants) {
+        std::cout << " " << v.name << "=" << v.timeMs << "ms" << (v.correct ? "" : "(FAIL)");
+        csv << v.name << "," << Bytes << "," << keys.size() << "," << v.timeMs << ","
+            << (v.correct ? "true" : "false") << "\n";
+        // Размер записи - часть имени алгоритма: группы истории не смешивают 16 и 256 байт
+        history.add(v.name + "_" + std::to_string(Bytes) + "B", "RANDOM", keys.size(), v.timeMs * 1e6);
+    }
+    std::cout << std::endl;
+}
+
+// Упакованные слова ключ+payload и структура массивов
+void benchmarkPackedAndColumns(const std::vector<int>& keys, std::ofstream& csv, ResultHistory& history) {
+    std::vector<uint64_t> words(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        words[i] = RecordSort::pack(keys[i], static_cast<uint32_t>(i));
+    }
+    std::vector<uint64_t> reference = words;
+    double stdTime = measureMs([&] { std::sort(reference.begin(), reference.end()); });
+    double packedTime = measureMs([&] { RecordSort::sortPacked(words); });
+    bool packedCorrect = words == reference;
+
+    std::vector<int> columnKeys = keys;
+    std::vector<double> weights(keys.size());
+    std::vector<long long> ids(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        weights[i] = keys[i] * 0.5;
+        ids[i] = static_cast<long long>(i);
+    }
+    double soaTime = measureMs([&] { RecordSort::sortColumns(columnKeys, weights, ids); });
+    // Столбцы переставлены вместе с ключом, равные ключи - в исходном порядке
+    bool soaCorrect = std::is_sorted(columnKeys.begin(), columnKeys.end());
+    for (size_t i = 0; i < keys.size() && soaCorrect; i++) {
+        soaCorrect = columnKeys[i] == keys[ids[i]] && weights[i] == keys[ids[i]] * 0.5 &&
+                     (i == 0 || columnKeys[i] != columnKeys[i - 1] || ids[i] > ids[i - 1]);
+    }
+
+    std::cout << "  packed 8-byte words: std::sort=" << stdTime << "ms Packed_Radix=" << packedTime << "ms"
+              << (packedCorrect ? "" : "(FAIL)")
+              << ", SoA (int+double+int64): " << soaTime << "ms" << (soaCorrect ? "" : "(FAIL)") << std::endl;
+
+    csv << "std::sort_packed,8," << keys.size() << "," << stdTime << ",true\n";
+    csv << "Packed_Radix,8," << keys.size() << "," << packedTime << "," << (packedCorrect ? "true" : "false") << "\n";
+    csv << "SoA_Columns,20," << keys.size() << "," << soaTime << "," << (soaCorrect ? "true" : "false") << "\n";
+    history.add("std::sort_packed_8B", "RANDOM", keys.size(), stdTime * 1e6);
+    history.add("Packed_Radix_8B", "RANDOM", keys.size(), packedTime * 1e6);
+    history.add("SoA_Columns_20B", "RANDOM", keys.size(), soaTime * 1e6);
+}
+
+int main() {
+    std::vector<int> sizes = {10000, 100000, 1000000};
+
+    ResultHistory history("RecordSortBenchmark");
+    std::ofstream csv("record_sort_results.csv");
+    csv << "Algorithm,RecordBytes,Size,TimeMs,Correct\n";
+
+    std::cout << "=== RECORD SORTING: std::sort on structs vs key-index permutation ===" << std::endl;
+    for (int size : sizes) {
+        std::cout << "Size: " << size << std::endl;
+        std::vector<int> keys = DataGenerator::generateData(size, DataGenerator::RANDOM);
+        benchmarkRecords<16>(keys, csv, history);
+        benchmarkRecords<64>(keys, csv, history);
+        benchmarkRecords<256>(keys, csv, history);
+        benchmarkPackedAndColumns(keys, csv, history);
+    }
+
+    std::cout << "Results saved to 'record_sort_results.csv'" << std::endl;
+    history.save();
+    return 0;
+}
@@ -0,0 +1,255 @@
+#ifndef RESULT_HISTORY_H
+#define RESULT_HISTORY_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <process.h>
+#define RESULT_HISTORY_POPEN _popen
+#define RESULT_HISTORY_PCLOSE _pclose
+#define RESULT_HISTORY_GETPID _getpid
+#else
+#include <unistd.h>
+#define RESULT_HISTORY_POPEN popen
+#define RESULT_HISTORY_PCLOSE pclose
+#define RESULT_HISTORY_GETPID getpid
+#endif
+
+// Общая история замеров: одна CSV-таблица, в которую драйверы только дописывают строки.
+// Все строки одного прогона имеют общий RunId и помечены коммитом, компилятором, флагами
+// сборки и моделью процессора - по ним видно, сравнимы ли два прогона.
+// Одна строка - один замер одного алгоритма на одном типе данных и размере.
+// Пишут: sorting_experiment (task-2), SortingComparison, RecordSortBenchmark,
+// PolicySortBenchmark, StringSortBenchmark, SortedLogBenchmark. Не пишут SortBenchmark
+// (у Google Benchmark свой JSON, --benchmark_out) и HugePageBenchmark (huge_page_results.csv).
+// Сравнение прогонов и поиск регрессий - history_compare.cpp.
+// Путь: переменная окружения SORT_HISTORY, иначе RESULT_HISTORY_PATH из сборки
+// (CMakeLists.txt, task-2/run), иначе benchmark_history.csv в текущем каталоге.
+// Коммит берется из RESULT_HISTORY_SOURCE_DIR, флаги - из RESULT_HISTORY_FLAGS (тоже из сборки).
+// Заголовок без C++14, его подключает и task-2 (-std=c++11)
+
+#ifndef RESULT_HISTORY_PATH
+#define RESULT_HISTORY_PATH "benchmark_history.csv"
+#endif
+
+class ResultHistory {
+public:
+    struct Record {
+        std::string runId;
+        std::string timestamp;
+        std::string commit;
+        std::string compiler;
+        std::string flags;
+        std::string cpu;
+        std::string driver;
+        std::string algorithm;
+        std::string pattern;
+        long long size;
+        double timeNs;
+    };
+
+    static const char* header() {
+        return "RunId,Timestamp,Commit,Compiler,Flags,Cpu,Driver,Algorithm,Pattern,Size,TimeNs";
+    }
+
+    // Метки прогона снимаются один раз при создании, строки копятся в памяти до save()
+    explicit ResultHistory(const std::string& driver) {
+        std::time_t now = std::time(nullptr);
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+        char id[32];
+        std::strftime(id, sizeof(id), "%Y%m%d-%H%M%S", std::localtime(&now));
+
+        run.runId = std::string(id) + "-" + std::to_string(static_cast<long long>(RESULT_HISTORY_GETPID()));
+        run.timestamp = stamp;
+        run.commit = currentCommit();
+        run.compiler = compilerVersion();
+        run.flags = buildFlags();
+        run.cpu = cpuModel();
+        run.driver = clean(driver);
+        run.size = 0;
+        run.timeNs = 0;
+    }
+
+    void add(const std::string& algorithm, const std::string& pattern, long long size, double timeNs) {
+        Record record = run;
+        record.algorithm = clean(algorithm);
+        record.pattern = clean(pattern);
+        record.size = size;
+        record.timeNs = timeNs;
+        pending.push_back(record);
+    }
+
+    // Дописывает накопленные строки в конец истории одной записью
+    bool save() {
+        std::string file = path();
+        bool fresh = true;
+        {
+            std::ifstream existing(file.c_str(), std::ios::binary | std::ios::ate);
+            fresh = !existing || existing.tellg() <= 0;
+        }
+
+        std::ostringstream rows;
+        rows.precision(12);
+        if (fresh) {
+            rows << header() << "\n";
+        }
+        for (size_t i = 0; i < pending.size(); i++) {
+            const Record& r = pending[i];
+            rows << r.runId << "," << r.timestamp << "," << r.commit << "," << r.compiler << ","
+                 << r.flags << "," << r.cpu << "," << r.driver << "," << r.algorithm << ","
+                 << r.pattern << "," << r.size << "," << r.timeNs << "\n";
+        }
+
+        std::ofstream out(file.c_str(), std::ios::app);
+        out << rows.str();
+        out.flush();
+        if (!out) {
+            std::cerr << "Cannot append to result history: " << file << std::endl;
+            return false;
+        }
+        std::cout << "Run " << run.runId << " (" << pending.size() << " rows, commit " << run.commit
+                  << ") appended to: " << file << std::endl;
+        pending.clear();
+        return true;
+    }
+
+    const std::string& runId() const { return run.runId; }
+
+    static std::string path() {
+        const char* env = std::getenv("SORT_HISTORY");
+        return env && *env ? env : RESULT_HISTORY_PATH;
+    }
+
+    // Строки с другим числом полей (оборванная запись) пропускаются
+    static std::vector<Record> load(const std::string& file) {
+        std::vector<Record> records;
+        std::ifstream in(file.c_str());
+        std::string line;
+        while (std::getline(in, line)) {
+            std::vector<std::string> fields;
+            std::stringstream stream(line);
+            std::string field;
+            while (std::getline(stream, field, ',')) {
+                fields.push_back(field);
+            }
+            if (fields.size() != 11 || fields[0] == "RunId") {
+                continue;
+            }
+            Record r;
+            r.runId = fields[0];
+            r.timestamp = fields[1];
+            r.commit = fields[2];
+            r.compiler = fields[3];
+            r.flags = fields[4];
+            r.cpu = fields[5];
+            r.driver = fields[6];
+            r.algorithm = fields[7];
+            r.pattern = fields[8];
+            char* end = nullptr;
+            r.size = std::strtoll(fields[9].c_str(), &end, 10);
+            r.timeNs = std::strtod(fields[10].c_str(), &end);
+            if (r.size <= 0) {
+                continue;
+            }
+            records.push_back(r);
+        }
+        return records;
+    }
+
+    // git describe по исходникам: короткий хеш и -dirty при незакоммиченных правках.
+    // Каталог исходников задает сборка (RESULT_HISTORY_SOURCE_DIR), иначе - текущий каталог:
+    // при сборке вне дерева (build/) или запуске из другого места он не тот репозиторий
+    static std::string currentCommit() {
+        std::string line = "git describe --always --dirty --abbrev=10 2>/dev/null";
+#if defined(RESULT_HISTORY_SOURCE_DIR)
+        line = std::string("git -C \"") + RESULT_HISTORY_SOURCE_DIR + "\" describe --always --dirty --abbrev=10 2>/dev/null";
+#endif
+        std::string commit = command(line.c_str());
+        return commit.empty() ? "unknown" : clean(commit);
+    }
+
+    static std::string compilerVersion() {
+#if defined(__clang__)
+        return clean(std::string("clang ") + __clang_version__);
+#elif defined(__GNUC__)
+        return clean(std::string("gcc ") + __VERSION__);
+#elif defined(_MSC_VER)
+        return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+        return "unknown";
+#endif
+    }
+
+    // RESULT_HISTORY_FLAGS задает сборка; без него - то, что видно по макросам компилятора
+    static std::string buildFlags() {
+#if defined(RESULT_HISTORY_FLAGS)
+        return clean(RESULT_HISTORY_FLAGS);
+#else
+        std::string flags;
+#if defined(__OPTIMIZE__)
+        flags += "optimized";
+#else
+        flags += "-O0";
+#endif
+#if defined(__AVX2__)
+        flags += " avx2";
+#endif
+        return flags;
+#endif
+    }
+
+    static std::string cpuModel() {
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(cpuinfo, line)) {
+            if (line.compare(0, 10, "model name") == 0) {
+                size_t colon = line.find(':');
+                if (colon != std::string::npos) {
+                    size_t start = line.find_first_not_of(' ', colon + 1);
+                    return clean(start == std::string::npos ? "" : line.substr(start));
+                }
+            }
+        }
+        std::string model = command("sysctl -n machdep.cpu.brand_string 2>/dev/null");
+        return model.empty() ? "unknown" : clean(model);
+    }
+
+private:
+    Record run; // Метки прогона; алгоритм, тип и замер заполняет add
+    std::vector<Record> pending;
+
+    // Поля без запятых и переводов строк, чтобы таблица читалась простым split
+    static std::string clean(const std::string& value) {
+        std::string result = value;
+        for (size_t i = 0; i < result.size(); i++) {
+            if (result[i] == ',') result[i] = ';';
+            if (result[i] == '\n' || result[i] == '\r' || result[i] == '"') result[i] = ' ';
+        }
+        size_t start = result.find_first_not_of(' ');
+        if (start == std::string::npos) return "";
+        return result.substr(start, result.find_last_not_of(' ') - start + 1);
+    }
+
+    static std::string command(const char* line) {
+        std::string output;
+        FILE* pipe = RESULT_HISTORY_POPEN(line, "r");
+        if (!pipe) return output;
+        char chunk[256];
+        while (std::fgets(chunk, sizeof(chunk), pipe)) {
+            output += chunk;
+        }
+        RESULT_HISTORY_PCLOSE(pipe);
+        size_t end = output.find_last_not_of(" \r\n");
+        return end == std::string::npos ? "" : output.substr(0, end + 1);
+    }
+};
+
+#endif
@@ -0,0 +1,449 @@
+#ifndef SIMD_SORT_H
+#define SIMD_SORT_H
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SIMD_SORT_X86 1
+#define SIMD_SORT_AVX2 __attribute__((target("avx2,popcnt")))
+#define SIMD_SORT_AVX512 __attribute__((target("avx512f,avx2,popcnt")))
+#endif
+
+// Векторные ядра сортировки int: базовые случаи гибридных сортировок
+// и отдельная векторная быстрая сортировка.
+// AVX2/AVX-512-код собирается с атрибутом target и вызывается только после проверки
+// процессора во время выполнения, иначе используется скалярный вариант.
+class SimdSort {
+public:
+    // Наибольший отрезок, который сортирует сеть
+    static const int kMaxNetwork = 64;
+
+    static bool hasAvx2() {
+#ifdef SIMD_SORT_X86
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    static bool hasAvx512() {
+#ifdef SIMD_SORT_X86
+        static const bool supported = __builtin_cpu_supports("avx512f");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    // Порог базового случая: сеть выгодна до 64 элементов, вставки - до 16
+    static int baseCaseLimit() {
+        return hasAvx2() ? kMaxNetwork : 16;
+    }
+
+    // Сортировка короткого отрезка (n <= baseCaseLimit())
+    static void sortSmall(int* data, int n) {
+        if (n <= 1) return;
+#ifdef SIMD_SORT_X86
+        if (n <= kMaxNetwork && hasAvx2()) {
+            sortNetworkAvx2(data, n);
+            return;
+        }
+#endif
+        insertionSort(data, n);
+    }
+
+    // Слияние отсортированных a[0..na) и b[0..nb) в out (out не пересекается со входами)
+    static void mergeRuns(const int* a, int na, const int* b, int nb, int* out) {
+#ifdef SIMD_SORT_X86
+        if (na >= 8 && nb >= 8 && hasAvx2()) {
+            mergeAvx2(a, na, b, nb, out);
+            return;
+        }
+#endif
+        mergeScalar(a, na, b, nb, out);
+    }
+
+    // Полностью векторная быстрая сортировка: разбиение со сжатием (compress-store
+    // на AVX-512, таблица перестановок на AVX2), опорный элемент - медиана выборки
+    // из 64 элементов, отсортированной сетью, листья - сортирующей сетью.
+    // Набор инструкций выбирается по процессору, без AVX2 - скалярное разбиение
+    static void quickSort(int* data, int n) {
+        if (n <= 1) return;
+        PartitionFunction partition = partitionScalar;
+#ifdef SIMD_SORT_X86
+        if (hasAvx512()) partition = partitionAvx512;
+        else if (hasAvx2()) partition = partitionAvx2;
+#endif
+        int depthLimit = 2;
+        for (int size = n; size > 1; size >>= 1) depthLimit += 2;
+        quickSortLoop(data, 0, n, depthLimit, partition);
+    }
+
+private:
+    // Разбиение [lo, hi) по pivot: возвращает mid, [lo, mid) <= pivot < [mid, hi)
+    typedef int (*PartitionFunction)(int* data, int lo, int hi, int pivot);
+
+    static void quickSortLoop(int* data, int lo, int hi, int depthLimit, PartitionFunction partition) {
+        while (hi - lo > kMaxNetwork) {
+            if (depthLimit-- == 0) {
+                std::make_heap(data + lo, data + hi);
+                std::sort_heap(data + lo, data + hi);
+                return;
+            }
+            int pivot = choosePivot(data, lo, hi);
+            int mid = partition(data, lo, hi, pivot);
+            if (mid == hi) {
+                // Все <= pivot: отделяем равные pivot, они уже на своих местах
+                if (pivot == INT_MIN) return;
+                hi = partition(data, lo, hi, pivot - 1);
+                continue;
+            }
+            // Рекурсия в меньшую часть, цикл по большей: глубина стека O(log n)
+            if (mid - lo < hi - mid) {
+                quickSortLoop(data, lo, mid, depthLimit, partition);
+                lo = mid;
+            } else {
+                quickSortLoop(data, mid, hi, depthLimit, partition);
+                hi = mid;
+            }
+        }
+        sortSmall(data + lo, hi - lo);
+    }
+
+    // Медиана равномерной выборки; выборка сортируется той же сетью
+    static int choosePivot(const int* data, int lo, int hi) {
+        int n = hi - lo;
+        int count = n >= 1024 ? 64 : 16;
+        int step = n / count;
+        int sample[64];
+        for (int i = 0; i < count; i++) {
+            sample[i] = data[lo + i * step + step / 2];
+        }
+        sortSmall(sample, count);
+        return sample[count / 2];
+    }
+
+    static int partitionScalar(int* data, int lo, int hi, int pivot) {
+        int i = lo;
+        int j = hi - 1;
+        while (true) {
+            while (i <= j && data[i] <= pivot) i++;
+            while (i <= j && data[j] > pivot) j--;
+            if (i >= j) return i;
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    static void insertionSort(int* data, int n) {
+        for (int i = 1; i < n; i++) {
+            int key = data[i];
+            int j = i - 1;
+            while (j >= 0 && data[j] > key) {
+                data[j + 1] = data[j];
+                j--;
+            }
+            data[j + 1] = key;
+        }
+    }
+
+    static void mergeScalar(const int* a, int na, const int* b, int nb, int* out) {
+        int i = 0, j = 0, k = 0;
+        while (i < na && j < nb) {
+            if (a[i] <= b[j]) out[k++] = a[i++];
+            else out[k++] = b[j++];
+        }
+        while (i < na) out[k++] = a[i++];
+        while (j < nb) out[k++] = b[j++];
+    }
+
+#ifdef SIMD_SORT_X86
+    // Битонная сеть в варианте, где меньший элемент всегда остается слева:
+    // первый шаг слияния блока сравнивает i с (конец блока - i), дальше идут
+    // полуочистители с шагом j. Внутри регистра шаги делаются перестановками
+    // и blend: маска отмечает дорожки, которые получают максимум.
+
+    SIMD_SORT_AVX2 static inline __m256i reverse8(__m256i v) {
+        return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    }
+
+    // i <-> 7 - i
+    SIMD_SORT_AVX2 static inline __m256i flip8(__m256i v) {
+        __m256i p = reverse8(v);
+        return _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xF0);
+    }
+
+    // i <-> 3 - i в каждой четверке
+    SIMD_SORT_AVX2 static inline __m256i flip4(__m256i v) {
+        __m256i p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+        return _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xCC);
+    }
+
+    // i <-> i + 4
+    SIMD_SORT_AVX2 static inline __m256i half4(__m256i v) {
+        __m256i p = _mm256_permute2x128_si256(v, v, 1);
+        return _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xF0);
+    }
+
+    // i <-> i + 2
+    SIMD_SORT_AVX2 static inline __m256i half2(__m256i v) {
+        __m256i p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+        return _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xCC);
+    }
+
+    // i <-> i + 1 (он же первый шаг для блоков из двух)
+    SIMD_SORT_AVX2 static inline __m256i half1(__m256i v) {
+        __m256i p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+        return _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xAA);
+    }
+
+    SIMD_SORT_AVX2 static inline __m256i sort8(__m256i v) {
+        v = half1(v);
+        v = half1(flip4(v));
+        return half1(half2(flip8(v)));
+    }
+
+    // Сортирует любую битонную восьмерку
+    SIMD_SORT_AVX2 static inline __m256i merge8(__m256i v) {
+        return half1(half2(half4(v)));
+    }
+
+    // R регистров = 8 * R элементов, R - степень двойки
+    template <int R>
+    SIMD_SORT_AVX2 static inline void sortRegisters(__m256i* v) {
+        for (int i = 0; i < R; i++) {
+            v[i] = sort8(v[i]);
+        }
+        for (int k = 2; k <= R; k *= 2) {
+            for (int b = 0; b < R; b += k) {
+                for (int t = 0; t < k / 2; t++) {
+                    __m256i lo = v[b + t];
+                    __m256i hi = reverse8(v[b + k - 1 - t]);
+                    v[b + t] = _mm256_min_epi32(lo, hi);
+                    v[b + k - 1 - t] = reverse8(_mm256_max_epi32(lo, hi));
+                }
+            }
+            for (int j = k / 4; j >= 1; j /= 2) {
+                for (int i = 0; i < R; i++) {
+                    if ((i & j) == 0) {
+                        __m256i lo = v[i];
+                        v[i] = _mm256_min_epi32(lo, v[i + j]);
+                        v[i + j] = _mm256_max_epi32(lo, v[i + j]);
+                    }
+                }
+            }
+            for (int i = 0; i < R; i++) {
+                v[i] = merge8(v[i]);
+            }
+        }
+    }
+
+    template <int R>
+    SIMD_SORT_AVX2 static void sortBlock(int* data, int n) {
+        alignas(32) int buffer[8 * R];
+        for (int i = 0; i < n; i++) buffer[i] = data[i];
+        for (int i = n; i < 8 * R; i++) buffer[i] = INT_MAX;
+
+        __m256i v[R];
+        for (int i = 0; i < R; i++) {
+            v[i] = _mm256_load_si256(reinterpret_cast<const __m256i*>(buffer + 8 * i));
+        }
+        sortRegisters<R>(v);
+        for (int i = 0; i < R; i++) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(buffer + 8 * i), v[i]);
+        }
+        for (int i = 0; i < n; i++) data[i] = buffer[i];
+    }
+
+    // Дополняем до 8/16/32/64 значениями INT_MAX: они уходят в конец и не копируются назад
+    SIMD_SORT_AVX2 static void sortNetworkAvx2(int* data, int n) {
+        if (n <= 8) sortBlock<1>(data, n);
+        else if (n <= 16) sortBlock<2>(data, n);
+        else if (n <= 32) sortBlock<4>(data, n);
+        else sortBlock<8>(data, n);
+    }
+
+    // Слияние двух отсортированных восьмерок: lo - 8 меньших, hi - 8 больших
+    SIMD_SORT_AVX2 static inline void merge16(__m256i& lo, __m256i& hi) {
+        __m256i reversed = reverse8(hi);
+        __m256i l = _mm256_min_epi32(lo, reversed);
+        __m256i h = _mm256_max_epi32(lo, reversed);
+        lo = merge8(l);
+        hi = merge8(h);
+    }
+
+    // Векторное слияние: в регистре carry лежат 8 наибольших из уже прочитанных,
+    // следующая восьмерка берется из того входа, чей первый элемент меньше
+    SIMD_SORT_AVX2 static void mergeAvx2(const int* a, int na, const int* b, int nb, int* out) {
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+        __m256i carry = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+        merge16(low, carry);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), low);
+        int i = 8, j = 8, k = 8;
+
+        while (i + 8 <= na && j + 8 <= nb) {
+            __m256i next;
+            if (a[i] <= b[j]) {
+                next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                i += 8;
+            } else {
+                next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+                j += 8;
+            }
+            merge16(next, carry);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), next);
+            k += 8;
+        }
+
+        // Хвосты: три отсортированных источника - carry и остатки a и b
+        alignas(32) int rest[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(rest), carry);
+        int r = 0;
+        while (r < 8 || i < na || j < nb) {
+            int best = 0;
+            int value = INT_MAX;
+            bool found = false;
+            if (r < 8) { value = rest[r]; best = 0; found = true; }
+            if (i < na && (!found || a[i] < value)) { value = a[i]; best = 1; found = true; }
+            if (j < nb && (!found || b[j] < value)) { value = b[j]; best = 2; }
+            out[k++] = value;
+            if (best == 0) r++;
+            else if (best == 1) i++;
+            else j++;
+        }
+    }
+
+    // Таблица для эмуляции compress на AVX2: для маски "больше pivot" - номера дорожек,
+    // сначала элементы <= pivot, затем > pivot (по байту на дорожку)
+    static const uint64_t* compressTable() {
+        struct Table {
+            uint64_t entries[256];
+            Table() {
+                for (int mask = 0; mask < 256; mask++) {
+                    uint64_t packed = 0;
+                    int position = 0;
+                    for (int pass = 0; pass < 2; pass++) {
+                        for (int lane = 0; lane < 8; lane++) {
+                            if (((mask >> lane) & 1) == pass) {
+                                packed |= static_cast<uint64_t>(lane) << (8 * position++);
+                            }
+                        }
+                    }
+                    entries[mask] = packed;
+                }
+            }
+        };
+        static const Table table;
+        return table.entries;
+    }
+
+    // Переставить восьмерку: <= pivot в начало, > pivot в конец. Возвращает число > pivot
+    SIMD_SORT_AVX2 static inline int compressAvx2(__m256i& v, __m256i pivot, const uint64_t* table) {
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, pivot)));
+        __m256i order = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(table[mask])));
+        v = _mm256_permutevar8x32_epi32(v, order);
+        return __builtin_popcount(mask);
+    }
+
+    // Разбиение на месте: по восьмерке с каждого края держим в регистрах, поэтому
+    // между позициями записи и чтения всегда есть место под полные записи с обеих сторон.
+    // Читаем с той стороны, где места меньше
+    SIMD_SORT_AVX2 static int partitionAvx2(int* data, int lo, int hi, int pivot) {
+        const uint64_t* table = compressTable();
+        __m256i pv = _mm256_set1_epi32(pivot);
+        __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + lo));
+        __m256i last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + hi - 8));
+        int readL = lo + 8, readR = hi - 8;
+        int storeL = lo, storeR = hi;
+
+        while (readR - readL >= 8) {
+            __m256i v;
+            if (readL - storeL <= storeR - readR) {
+                v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + readL));
+                readL += 8;
+            } else {
+                readR -= 8;
+                v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + readR));
+            }
+            int greater = compressAvx2(v, pv, table);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + storeL), v);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + storeR - 8), v);
+            storeL += 8 - greater;
+            storeR -= greater;
+        }
+
+        // Остаток короче восьмерки - скалярно, предварительно скопировав
+        int tail[8];
+        int tailSize = readR - readL;
+        for (int i = 0; i < tailSize; i++) tail[i] = data[readL + i];
+        for (int i = 0; i < tailSize; i++) {
+            if (tail[i] <= pivot) data[storeL++] = tail[i];
+            else data[--storeR] = tail[i];
+        }
+
+        // Свободно ровно 16 мест: первая восьмерка пишется с обоих краев,
+        // последняя заполняет оставшиеся 8 мест одной записью
+        int greater = compressAvx2(first, pv, table);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + storeL), first);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + storeR - 8), first);
+        storeL += 8 - greater;
+        storeR -= greater;
+
+        greater = compressAvx2(last, pv, table);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + storeL), last);
+        return storeL + 8 - greater;
+    }
+
+    // Та же схема на 16 дорожках, но compress-store пишет ровно нужные элементы
+    SIMD_SORT_AVX512 static inline void compressStoreAvx512(int* data, __m512i v, __m512i pivot,
+                                                              int& storeL, int& storeR) {
+        __mmask16 greater = _mm512_cmpgt_epi32_mask(v, pivot);
+        int countGreater = __builtin_popcount(greater);
+        _mm512_mask_compressstoreu_epi32(data + storeL, static_cast<__mmask16>(~greater), v);
+        _mm512_mask_compressstoreu_epi32(data + storeR - countGreater, greater, v);
+        storeL += 16 - countGreater;
+        storeR -= countGreater;
+    }
+
+    SIMD_SORT_AVX512 static int partitionAvx512(int* data, int lo, int hi, int pivot) {
+        __m512i pv = _mm512_set1_epi32(pivot);
+        __m512i first = _mm512_loadu_si512(data + lo);
+        __m512i last = _mm512_loadu_si512(data + hi - 16);
+        int readL = lo + 16, readR = hi - 16;
+        int storeL = lo, storeR = hi;
+
+        while (readR - readL >= 16) {
+            __m512i v;
+            if (readL - storeL <= storeR - readR) {
+                v = _mm512_loadu_si512(data + readL);
+                readL += 16;
+            } else {
+                readR -= 16;
+                v = _mm512_loadu_si512(data + readR);
+            }
+            compressStoreAvx512(data, v, pv, storeL, storeR);
+        }
+
+        // Остаток - маскированной загрузкой
+        int tailSize = readR - readL;
+        __mmask16 tailMask = static_cast<__mmask16>((1u << tailSize) - 1);
+        __m512i tail = _mm512_maskz_loadu_epi32(tailMask, data + readL);
+        __mmask16 greater = _mm512_mask_cmpgt_epi32_mask(tailMask, tail, pv);
+        __mmask16 lessEqual = static_cast<__mmask16>(tailMask & ~greater);
+        int countGreater = __builtin_popcount(greater);
+        _mm512_mask_compressstoreu_epi32(data + storeL, lessEqual, tail);
+        _mm512_mask_compressstoreu_epi32(data + storeR - countGreater, greater, tail);
+        storeL += tailSize - countGreater;
+        storeR -= countGreater;
+
+        compressStoreAvx512(data, first, pv, storeL, storeR);
+        compressStoreAvx512(data, last, pv, storeL, storeR);
+        return storeL;
+    }
+#endif
+};
+
+#endif
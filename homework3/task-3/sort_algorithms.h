@@ -4,44 +4,57 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
+#include <type_traits>
+#include "simd_sort.h"
+#include "sort_policies.h"
+
+// Алгоритмы - шаблоны по типу элемента: от него требуется только operator<.
+// Для int дополнительно используются векторные ядра из simd_sort.h.
+// Вспомогательные буферы берутся у аллокатора входного вектора: для
+// HugePageVector (huge_page_allocator.h) они тоже лежат на больших страницах
 
 class SortAlgorithms {
 private:
-    // Вспомогательные функции для Heap Sort
-    static void heapify(std::vector<int>& arr, int n, int i) {
+    // Вспомогательные функции для Heap Sort.
+    // Куча из n элементов начинается с arr[base]: так отрезок сортируется на месте
+    template <typename T, typename Alloc>
+    static void heapify(std::vector<T, Alloc>& arr, int n, int i, int base = 0) {
         int largest = i;
         int left = 2 * i + 1;
         int right = 2 * i + 2;
 
-        if (left < n && arr[left] > arr[largest])
+        if (left < n && arr[base + largest] < arr[base + left])
             largest = left;
 
-        if (right < n && arr[right] > arr[largest])
+        if (right < n && arr[base + largest] < arr[base + right])
             largest = right;
 
         if (largest != i) {
-            std::swap(arr[i], arr[largest]);
-            heapify(arr, n, largest);
+            std::swap(arr[base + i], arr[base + largest]);
+            heapify(arr, n, largest, base);
         }
     }
 
-    static void buildHeap(std::vector<int>& arr, int n) {
+    template <typename T, typename Alloc>
+    static void buildHeap(std::vector<T, Alloc>& arr, int n, int base = 0) {
         for (int i = n / 2 - 1; i >= 0; i--)
-            heapify(arr, n, i);
+            heapify(arr, n, i, base);
     }
 
-    static int partition(std::vector<int>& arr, int low, int high) {
+    template <typename T, typename Alloc>
+    static int partition(std::vector<T, Alloc>& arr, int low, int high) {
         int randomIndex = low + rand() % (high - low + 1);
         std::swap(arr[randomIndex], arr[high]);
         
-        int pivot = arr[high];
+        T pivot = arr[high];
         int i = low - 1;
 
         for (int j = low; j < high; j++) {
-            if (arr[j] <= pivot) {
+            if (!(pivot < arr[j])) {
                 i++;
                 std::swap(arr[i], arr[j]);
             }
@@ -50,12 +63,13 @@ private:
         return i + 1;
     }
 
-    static void insertionSort(std::vector<int>& arr, int low, int high) {
+    template <typename T, typename Alloc>
+    static void insertionSort(std::vector<T, Alloc>& arr, int low, int high) {
         for (int i = low + 1; i <= high; i++) {
-            int key = arr[i];
+            T key = arr[i];
             int j = i - 1;
 
-            while (j >= low && arr[j] > key) {
+            while (j >= low && key < arr[j]) {
                 arr[j + 1] = arr[j];
                 j--;
             }
@@ -63,74 +77,341 @@ private:
         }
     }
 
-    static void heapSortPartial(std::vector<int>& arr, int low, int high) {
-        int n = high - low + 1;
-        std::vector<int> temp(n);
-        
-        for (int i = 0; i < n; i++) {
-            temp[i] = arr[low + i];
+    template <typename T, typename Alloc>
+    static void quickSortStandardRecursive(std::vector<T, Alloc>& arr, int low, int high) {
+        if (low < high) {
+            int pi = partition(arr, low, high);
+            quickSortStandardRecursive(arr, low, pi - 1);
+            quickSortStandardRecursive(arr, pi + 1, high);
         }
+    }
 
-        buildHeap(temp, n);
-
-        for (int i = n - 1; i >= 0; i--) {
-            std::swap(temp[0], temp[i]);
-            heapify(temp, i, 0);
+    // Слияние [low, mid] и [mid + 1, high] через буфер. При равных ключах
+    // первым берется элемент левой половины - отсюда устойчивость
+    template <typename T, typename Alloc>
+    static void merge(std::vector<T, Alloc>& arr, std::vector<T, Alloc>& buffer, int low, int mid, int high) {
+        int i = low, j = mid + 1, k = low;
+        while (i <= mid && j <= high) {
+            if (arr[j] < arr[i]) {
+                buffer[k++] = arr[j++];
+            } else {
+                buffer[k++] = arr[i++];
+            }
         }
+        while (i <= mid) buffer[k++] = arr[i++];
+        while (j <= high) buffer[k++] = arr[j++];
+        for (k = low; k <= high; k++) {
+            arr[k] = buffer[k];
+        }
+    }
 
-        for (int i = 0; i < n; i++) {
-            arr[low + i] = temp[i];
+    template <typename T, typename Alloc>
+    static void mergeSortRecursive(std::vector<T, Alloc>& arr, std::vector<T, Alloc>& buffer, int low, int high) {
+        if (high - low < 16) {
+            insertionSort(arr, low, high); // Вставки тоже устойчивы
+            return;
+        }
+        int mid = low + (high - low) / 2;
+        mergeSortRecursive(arr, buffer, low, mid);
+        mergeSortRecursive(arr, buffer, mid + 1, high);
+        if (arr[mid + 1] < arr[mid]) {
+            merge(arr, buffer, low, mid, high);
         }
     }
 
-    static void quickSortStandardRecursive(std::vector<int>& arr, int low, int high) {
-        if (low < high) {
-            int pi = partition(arr, low, high);
-            quickSortStandardRecursive(arr, low, pi - 1);
-            quickSortStandardRecursive(arr, pi + 1, high);
+    // Трехчастное разбиение Дейкстры: [< pivot][== pivot][> pivot].
+    // Равные опорному элементы больше не участвуют в рекурсии
+    template <typename T, typename Alloc>
+    static void quickSort3WayRecursive(std::vector<T, Alloc>& arr, int low, int high) {
+        while (high - low >= 16) {
+            std::swap(arr[low], arr[low + rand() % (high - low + 1)]);
+            T pivot = arr[low];
+            int lt = low, i = low + 1, gt = high;
+            while (i <= gt) {
+                if (arr[i] < pivot) {
+                    std::swap(arr[lt++], arr[i++]);
+                } else if (pivot < arr[i]) {
+                    std::swap(arr[i], arr[gt--]);
+                } else {
+                    i++;
+                }
+            }
+            // Рекурсия в меньшую часть, цикл - по большей
+            if (lt - low < high - gt) {
+                quickSort3WayRecursive(arr, low, lt - 1);
+                low = gt + 1;
+            } else {
+                quickSort3WayRecursive(arr, gt + 1, high);
+                high = lt - 1;
+            }
         }
+        insertionSort(arr, low, high);
     }
 
-    static void quickSortHybridRecursive(std::vector<int>& arr, int low, int high, int depthLimit) {
-        if (high - low < 16) {
-            insertionSort(arr, low, high);
-            return;
+    // Характеристики входа по выборке: несколько коротких окон для упорядоченности
+    // и равномерная выборка значений для доли повторов
+    struct InputProfile {
+        double descentRatio;  // Доля соседних пар a[i+1] < a[i] в окнах
+        double distinctRatio; // Доля различных значений в выборке
+    };
+
+    template <typename T, typename Alloc>
+    static InputProfile profileInput(const std::vector<T, Alloc>& arr) {
+        const size_t windows = 32, width = 8;
+        const size_t n = arr.size();
+        const size_t samples = n < 256 ? n : 256;
+        InputProfile profile;
+
+        int descents = 0;
+        for (size_t w = 0; w < windows; w++) {
+            size_t start = (n - width) * w / (windows - 1);
+            for (size_t i = start; i + 1 < start + width; i++) {
+                descents += arr[i + 1] < arr[i];
+            }
         }
+        profile.descentRatio = static_cast<double>(descents) / (windows * (width - 1));
 
-        if (depthLimit == 0) {
-            heapSortPartial(arr, low, high);
-            return;
+        std::vector<T> sample;
+        sample.reserve(samples);
+        for (size_t i = 0; i < samples; i++) {
+            sample.push_back(arr[n * i / samples]);
+        }
+        std::sort(sample.begin(), sample.end());
+        int distinct = 1;
+        for (size_t i = 1; i < samples; i++) {
+            distinct += sample[i - 1] < sample[i];
         }
+        profile.distinctRatio = static_cast<double>(distinct) / samples;
+        return profile;
+    }
 
-        // Обычный Quick Sort
-        int pi = partition(arr, low, high);
-        quickSortHybridRecursive(arr, low, pi - 1, depthLimit - 1);
-        quickSortHybridRecursive(arr, pi + 1, high, depthLimit - 1);
+    // Разбить массив на неубывающие серии (строго убывающие разворачиваются).
+    // Возвращает false, если серий больше maxRuns - тогда сливать невыгодно
+    template <typename T, typename Alloc>
+    static bool findRuns(std::vector<T, Alloc>& arr, std::vector<int>& runStarts, size_t maxRuns) {
+        const int n = arr.size();
+        int i = 0;
+        while (i < n) {
+            if (runStarts.size() >= maxRuns) return false;
+            runStarts.push_back(i);
+            int j = i + 1;
+            if (j < n && arr[j] < arr[i]) {
+                while (j < n && arr[j] < arr[j - 1]) j++;
+                std::reverse(arr.begin() + i, arr.begin() + j);
+            } else {
+                while (j < n && !(arr[j] < arr[j - 1])) j++;
+            }
+            i = j;
+        }
+        runStarts.push_back(n);
+        return true;
     }
 
 public:
+    // Какой алгоритм выбрал sort (для отчетов и калибровки)
+    enum Engine {
+        ENGINE_INSERTION,
+        ENGINE_RUN_MERGE,
+        ENGINE_RADIX,
+        ENGINE_THREE_WAY,
+        ENGINE_INTROSORT
+    };
+
+    static const char* engineName(Engine engine) {
+        static const char* names[] = {"Insertion", "RunMerge", "Radix", "ThreeWay", "Introsort"};
+        return names[engine];
+    }
+
+    // Выбор алгоритма по выборке из входа (около 500 сравнений, ~2 мкс при любом n).
+    // Пороги - по замерам всех алгоритмов на данных DataGenerator, n от 100 до 2^22:
+    //  - до 64 элементов сеть/вставки быстрее всего остального;
+    //  - почти без спусков в окнах (SORTED) или почти сплошь спуски (REVERSED) -
+    //    слияние естественных серий, на 2^20 в 5 раз быстрее лучшей быстрой сортировки;
+    //  - int с AVX2: векторная быстрая сортировка быстрее всех остальных,
+    //    в том числе на FEW_UNIQUE (повторы она отделяет сама);
+    //  - int без AVX2: поразрядная сортировка выигрывает у интроспективной уже
+    //    с ~200 элементов при любом диапазоне значений;
+    //  - прочие типы: при доле различных значений до 1/8 трехчастное разбиение
+    //    в 3 раза быстрее интроспективной сортировки
+    template <typename T, typename Alloc>
+    static Engine chooseEngine(const std::vector<T, Alloc>& arr) {
+        const size_t n = arr.size();
+        if (n <= 64) return ENGINE_INSERTION;
+        InputProfile profile = profileInput(arr);
+        if (profile.descentRatio <= 0.02 || profile.descentRatio >= 0.98) return ENGINE_RUN_MERGE;
+        if constexpr (std::is_same<T, int>::value) {
+            if (!SimdSort::hasAvx2() && n >= 192) return ENGINE_RADIX;
+        } else {
+            if (profile.distinctRatio <= 0.125) return ENGINE_THREE_WAY;
+        }
+        return ENGINE_INTROSORT;
+    }
+
+    // Единая точка входа: сама выбирает алгоритм под данные
+    template <typename T, typename Alloc>
+    static void sort(std::vector<T, Alloc>& arr) {
+        if (arr.size() <= 1) return;
+        Engine engine = chooseEngine(arr);
+        if (engine == ENGINE_RUN_MERGE && !naturalMergeSort(arr, arr.size() / 64 + 1)) {
+            engine = ENGINE_INTROSORT; // Серий оказалось слишком много
+        }
+        switch (engine) {
+            case ENGINE_INSERTION:
+                if constexpr (std::is_same<T, int>::value) {
+                    if (static_cast<int>(arr.size()) <= SimdSort::baseCaseLimit()) {
+                        SimdSort::sortSmall(arr.data(), arr.size());
+                        break;
+                    }
+                }
+                insertionSort(arr);
+                break;
+            case ENGINE_RUN_MERGE:
+                break; // Уже отсортирован в naturalMergeSort
+            case ENGINE_RADIX:
+                if constexpr (std::is_same<T, int>::value) {
+                    radixSort(arr);
+                }
+                break;
+            case ENGINE_THREE_WAY:
+                quickSort3Way(arr);
+                break;
+            case ENGINE_INTROSORT:
+                if constexpr (std::is_same<T, int>::value) {
+                    if (SimdSort::hasAvx2()) {
+                        quickSortVectorized(arr);
+                        break;
+                    }
+                }
+                quickSortHybrid(arr);
+                break;
+        }
+    }
+
     // Стандартный Quick Sort
-    static void quickSortStandard(std::vector<int>& arr) {
+    template <typename T, typename Alloc>
+    static void quickSortStandard(std::vector<T, Alloc>& arr) {
         if (arr.size() <= 1) return;
         quickSortStandardRecursive(arr, 0, arr.size() - 1);
     }
 
-    // Гибридный Introsort
-    static void quickSortHybrid(std::vector<int>& arr) {
+    // Гибридный Introsort: случайный опорный, разбиение Ломуто, Heap Sort после
+    // глубины 2 * log2(n); короткие отрезки int - сортирующей сетью, прочие - вставками.
+    // Другие сочетания политик - PolicyQuickSort из sort_policies.h
+    template <typename T>
+    using HybridQuickSort = PolicyQuickSort<RandomPivot, LomutoPartition, NetworkBase,
+                                            std::is_same<T, int>::value ? SimdSort::kMaxNetwork : 16,
+                                            HeapFallback>;
+
+    template <typename T, typename Alloc>
+    static void quickSortHybrid(std::vector<T, Alloc>& arr) {
+        HybridQuickSort<T>::sort(arr);
+    }
+
+    // Векторная быстрая сортировка (AVX-512/AVX2 по возможностям процессора)
+    template <typename Alloc>
+    static void quickSortVectorized(std::vector<int, Alloc>& arr) {
         if (arr.size() <= 1) return;
-        
-        // Вычисляем максимальную глубину рекурсии: 2 * log2(n)
-        int depthLimit = 2 * static_cast<int>(log2(arr.size()));
-        quickSortHybridRecursive(arr, 0, arr.size() - 1, depthLimit);
+        SimdSort::quickSort(arr.data(), static_cast<int>(arr.size()));
+    }
+
+    // Quick Sort с трехчастным разбиением: быстр на массивах с большим числом повторов
+    template <typename T, typename Alloc>
+    static void quickSort3Way(std::vector<T, Alloc>& arr) {
+        if (arr.size() <= 1) return;
+        quickSort3WayRecursive(arr, 0, arr.size() - 1);
+    }
+
+    // LSD Radix Sort по байтам (знаковый бит инвертируется). Проходы, в которых
+    // у всех элементов одинаковый байт, пропускаются: узкий диапазон - меньше проходов
+    template <typename Alloc>
+    static void radixSort(std::vector<int, Alloc>& arr) {
+        const size_t n = arr.size();
+        if (n <= 1) return;
+
+        size_t counts[4][256] = {};
+        for (int value : arr) {
+            uint32_t key = static_cast<uint32_t>(value) ^ 0x80000000u;
+            for (int pass = 0; pass < 4; pass++) {
+                counts[pass][(key >> (8 * pass)) & 0xFF]++;
+            }
+        }
+
+        std::vector<int, Alloc> buffer(n, arr.get_allocator());
+        int* from = arr.data();
+        int* to = buffer.data();
+        for (int pass = 0; pass < 4; pass++) {
+            size_t* count = counts[pass];
+            uint32_t first = static_cast<uint32_t>(from[0]) ^ 0x80000000u;
+            if (count[(first >> (8 * pass)) & 0xFF] == n) {
+                continue;
+            }
+            size_t offset = 0;
+            for (int digit = 0; digit < 256; digit++) {
+                size_t c = count[digit];
+                count[digit] = offset;
+                offset += c;
+            }
+            for (size_t i = 0; i < n; i++) {
+                uint32_t key = static_cast<uint32_t>(from[i]) ^ 0x80000000u;
+                to[count[(key >> (8 * pass)) & 0xFF]++] = from[i];
+            }
+            std::swap(from, to);
+        }
+        if (from != arr.data()) {
+            arr.swap(buffer);
+        }
+    }
+
+    // Слияние естественных серий (убывающие серии разворачиваются). На уже
+    // упорядоченном входе - один проход. Если серий больше maxRuns, массив
+    // остается переставленным, но не отсортированным, и возвращается false
+    template <typename T, typename Alloc>
+    static bool naturalMergeSort(std::vector<T, Alloc>& arr, size_t maxRuns) {
+        std::vector<int> runStarts;
+        if (!findRuns(arr, runStarts, maxRuns)) return false;
+
+        std::vector<T, Alloc> buffer(arr.size(), arr.get_allocator());
+        while (runStarts.size() > 2) {
+            std::vector<int> merged;
+            size_t r = 0;
+            for (; r + 2 < runStarts.size(); r += 2) {
+                int a = runStarts[r], b = runStarts[r + 1], c = runStarts[r + 2];
+                if constexpr (std::is_same<T, int>::value) {
+                    SimdSort::mergeRuns(&arr[a], b - a, &arr[b], c - b, &buffer[a]);
+                } else {
+                    std::merge(arr.begin() + a, arr.begin() + b, arr.begin() + b, arr.begin() + c,
+                               buffer.begin() + a);
+                }
+                std::copy(buffer.begin() + a, buffer.begin() + c, arr.begin() + a);
+                merged.push_back(a);
+            }
+            if (r + 1 < runStarts.size()) {
+                merged.push_back(runStarts[r]); // Непарная последняя серия
+            }
+            merged.push_back(arr.size());
+            runStarts.swap(merged);
+        }
+        return true;
+    }
+
+    // Merge Sort: устойчивая сортировка для многоключевых проходов
+    // (сначала по второстепенному ключу, затем по главному)
+    template <typename T, typename Alloc>
+    static void mergeSort(std::vector<T, Alloc>& arr) {
+        if (arr.size() <= 1) return;
+        std::vector<T, Alloc> buffer(arr.size(), arr.get_allocator());
+        mergeSortRecursive(arr, buffer, 0, arr.size() - 1);
     }
 
     // Insertion Sort (для сравнения)
-    static void insertionSort(std::vector<int>& arr) {
+    template <typename T, typename Alloc>
+    static void insertionSort(std::vector<T, Alloc>& arr) {
         insertionSort(arr, 0, arr.size() - 1);
     }
 
     // Heap Sort (для сравнения)
-    static void heapSort(std::vector<int>& arr) {
+    template <typename T, typename Alloc>
+    static void heapSort(std::vector<T, Alloc>& arr) {
         int n = arr.size();
         if (n <= 1) return;
 
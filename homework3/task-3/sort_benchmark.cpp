@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "../task-2/SortTester.h"
+#include "alloc_telemetry.h"
+#include "data_generator.h"
+#include "sort_algorithms.h"
+
+// Единый набор замеров для всех сортировок из task-2 и task-3 в формате Google Benchmark.
+// Каждая сортировка x каждый тип данных DataGenerator x каждый размер.
+// Счетчики: items/bytes в секунду и выделения памяти одной сортировкой.
+// Результаты пишутся в JSON (sort_benchmark_results.json), их можно сравнивать между сборками.
+// Запуск только части: ./SortBenchmark --benchmark_filter=quickSort.*/RANDOM/
+
+using SortFunction = void (*)(std::vector<int>&);
+
+struct Engine {
+    const char* name;
+    SortFunction sort;
+    int maxSize; // Квадратичные сортировки на больших массивах не запускаем
+};
+
+static const Engine engines[] = {
+    {"mergeSort", [](std::vector<int>& arr) { SortTester::mergeSort(arr, 0, static_cast<int>(arr.size()) - 1); }, 1 << 20},
+    {"hybridMergeSort", [](std::vector<int>& arr) { SortTester::hybridMergeSort(arr, 0, static_cast<int>(arr.size()) - 1, 10); }, 1 << 20},
+    {"mergeSortStable", [](std::vector<int>& arr) { SortAlgorithms::mergeSort(arr); }, 1 << 20},
+    {"quickSortStandard", [](std::vector<int>& arr) { SortAlgorithms::quickSortStandard(arr); }, 1 << 20},
+    {"quickSortHybrid", [](std::vector<int>& arr) { SortAlgorithms::quickSortHybrid(arr); }, 1 << 20},
+    {"quickSortVectorized", [](std::vector<int>& arr) { SortAlgorithms::quickSortVectorized(arr); }, 1 << 20},
+    {"heapSort", [](std::vector<int>& arr) { SortAlgorithms::heapSort(arr); }, 1 << 20},
+    {"insertionSort", [](std::vector<int>& arr) { SortAlgorithms::insertionSort(arr); }, 1 << 14},
+    {"std::sort", [](std::vector<int>& arr) { std::sort(arr.begin(), arr.end()); }, 1 << 20},
+    {"std::stable_sort", [](std::vector<int>& arr) { std::stable_sort(arr.begin(), arr.end()); }, 1 << 20},
+};
+
+static const DataGenerator::DataType dataTypes[] = {
+    DataGenerator::RANDOM,
+    DataGenerator::SORTED,
+    DataGenerator::REVERSED,
+    DataGenerator::NEARLY_SORTED,
+    DataGenerator::FEW_UNIQUE
+};
+
+static const char* dataTypeNames[] = {
+    "RANDOM", "SORTED", "REVERSED", "NEARLY_SORTED", "FEW_UNIQUE"
+};
+
+static const int sizes[] = {1 << 10, 1 << 14, 1 << 17, 1 << 20};
+
+// Данные генерируются один раз на замер, копирование в каждой итерации не входит во время.
+// Память считается отдельным прогоном до замеров: учет RSS слишком дорог для каждой итерации
+static void runSort(benchmark::State& state, SortFunction sort, DataGenerator::DataType type) {
+    const int size = static_cast<int>(state.range(0));
+    const std::vector<int> original = DataGenerator::generateData(size, type);
+    std::vector<int> data = original;
+
+    AllocTelemetry::Scope scope;
+    sort(data);
+    AllocTelemetry::Stats memory = scope.finish();
+    state.counters["allocs"] = static_cast<double>(memory.allocations);
+    state.counters["alloc_bytes"] = static_cast<double>(memory.bytes);
+    state.counters["peak_extra_bytes"] = static_cast<double>(memory.peakBytes);
+    state.counters["rss_delta_kb"] = static_cast<double>(memory.rssDeltaKb);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        data = original;
+        state.ResumeTiming();
+        sort(data);
+        benchmark::DoNotOptimize(data.data());
+        benchmark::ClobberMemory();
+    }
+
+    if (!std::is_sorted(data.begin(), data.end())) {
+        state.SkipWithError("result is not sorted");
+        return;
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+    state.SetBytesProcessed(state.iterations() * size * static_cast<int64_t>(sizeof(int)));
+}
+
+int main(int argc, char** argv) {
+    for (const Engine& engine : engines) {
+        for (size_t t = 0; t < sizeof(dataTypes) / sizeof(dataTypes[0]); t++) {
+            std::string name = std::string(engine.name) + "/" + dataTypeNames[t];
+            auto* bench = benchmark::RegisterBenchmark(name.c_str(), runSort, engine.sort, dataTypes[t]);
+            for (int size : sizes) {
+                if (size <= engine.maxSize) {
+                    bench->Arg(size);
+                }
+            }
+            bench->Unit(benchmark::kMicrosecond);
+        }
+    }
+
+    // По умолчанию дублируем результаты в JSON-файл, если путь не задан явно
+    std::vector<char*> args(argv, argv + argc);
+    std::string out = "--benchmark_out=sort_benchmark_results.json";
+    std::string format = "--benchmark_out_format=json";
+    bool hasOut = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]).rfind("--benchmark_out=", 0) == 0) {
+            hasOut = true;
+        }
+    }
+    if (!hasOut) {
+        args.push_back(&out[0]);
+        args.push_back(&format[0]);
+    }
+    int count = static_cast<int>(args.size());
+
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
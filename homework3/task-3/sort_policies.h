@@ -0,0 +1,288 @@
+#ifndef SORT_POLICIES_H
+#define SORT_POLICIES_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "simd_sort.h"
+
+// Сборка сортировки из политик во время компиляции.
+// Быстрая сортировка = выбор опорного + разбиение + базовый случай + порог + запасной алгоритм,
+// сортировка слиянием = базовый случай + порог. Каждая политика - структура со статическими
+// функциями, порог - параметр шаблона, поэтому каждая комбинация - отдельная функция
+// без указателей на функции и без проверок настроек на каждом уровне рекурсии.
+// Имя комбинации (name()) - для таблиц замеров, см. policy_sort_benchmark.cpp
+
+#if defined(__GNUC__)
+#define SORT_POLICY_INLINE __attribute__((always_inline)) inline
+#else
+#define SORT_POLICY_INLINE inline
+#endif
+
+// ---- Выбор опорного: индекс опорного элемента в [low, high] ----
+
+// Случайный элемент (как в исходном quickSortHybrid)
+struct RandomPivot {
+    static const char* name() { return "Random"; }
+
+    template <typename T>
+    static SORT_POLICY_INLINE int select(const T*, int low, int high) {
+        return low + rand() % (high - low + 1);
+    }
+};
+
+// Медиана первого, среднего и последнего
+struct MedianOfThreePivot {
+    static const char* name() { return "Median3"; }
+
+    template <typename T>
+    static SORT_POLICY_INLINE int median(const T* a, int i, int j, int k) {
+        if (a[i] < a[j]) {
+            if (a[j] < a[k]) return j;
+            return a[i] < a[k] ? k : i;
+        }
+        if (a[i] < a[k]) return i;
+        return a[j] < a[k] ? k : j;
+    }
+
+    template <typename T>
+    static SORT_POLICY_INLINE int select(const T* a, int low, int high) {
+        return median(a, low, low + (high - low) / 2, high);
+    }
+};
+
+// Псевдомедиана Тьюки (медиана трех медиан из девяти) на больших отрезках
+struct NintherPivot {
+    static const char* name() { return "Ninther"; }
+
+    template <typename T>
+    static SORT_POLICY_INLINE int select(const T* a, int low, int high) {
+        int n = high - low + 1;
+        int mid = low + n / 2;
+        if (n < 128) {
+            return MedianOfThreePivot::median(a, low, mid, high);
+        }
+        int step = n / 8;
+        int first = MedianOfThreePivot::median(a, low, low + step, low + 2 * step);
+        int second = MedianOfThreePivot::median(a, mid - step, mid, mid + step);
+        int third = MedianOfThreePivot::median(a, high - 2 * step, high - step, high);
+        return MedianOfThreePivot::median(a, first, second, third);
+    }
+};
+
+// ---- Разбиение [low, high] по опорному a[pivot] ----
+// Результат: дальше сортируются [low, leftHigh] и [rightLow, high]
+
+struct PartitionSplit {
+    int leftHigh;
+    int rightLow;
+};
+
+// Ломуто: один указатель, опорный встает на свое место (как в исходном partition)
+struct LomutoPartition {
+    static const char* name() { return "Lomuto"; }
+
+    template <typename T>
+    static SORT_POLICY_INLINE PartitionSplit partition(T* a, int low, int high, int pivot) {
+        std::swap(a[pivot], a[high]);
+        T value = a[high];
+        int i = low - 1;
+        for (int j = low; j < high; j++) {
+            if (!(value < a[j])) {
+                std::swap(a[++i], a[j]);
+            }
+        }
+        std::swap(a[i + 1], a[high]);
+        return {i, i + 2};
+    }
+};
+
+// Хоар: два встречных указателя, вдвое меньше обменов, равные делятся пополам
+struct HoarePartition {
+    static const char* name() { return "Hoare"; }
+
+    template <typename T>
+    static SORT_POLICY_INLINE PartitionSplit partition(T* a, int low, int high, int pivot) {
+        std::swap(a[pivot], a[low]); // Опорный в начале - тогда j < high, разбиение не вырождается
+        T value = a[low];
+        int i = low - 1, j = high + 1;
+        while (true) {
+            do i++; while (a[i] < value);
+            do j--; while (value < a[j]);
+            if (i >= j) return {j, j + 1};
+            std::swap(a[i], a[j]);
+        }
+    }
+};
+
+// Трехчастное разбиение Дейкстры: равные опорному исключаются из рекурсии
+struct ThreeWayPartition {
+    static const char* name() { return "ThreeWay"; }
+
+    template <typename T>
+    static SORT_POLICY_INLINE PartitionSplit partition(T* a, int low, int high, int pivot) {
+        std::swap(a[pivot], a[low]);
+        T value = a[low];
+        int lt = low, i = low + 1, gt = high;
+        while (i <= gt) {
+            if (a[i] < value) {
+                std::swap(a[lt++], a[i++]);
+            } else if (value < a[i]) {
+                std::swap(a[i], a[gt--]);
+            } else {
+                i++;
+            }
+        }
+        return {lt - 1, gt + 1};
+    }
+};
+
+// ---- Базовый случай: отрезок не длиннее порога ----
+
+struct InsertionBase {
+    static const char* name() { return "Insertion"; }
+
+    template <typename T>
+    static SORT_POLICY_INLINE void sort(T* a, int n) {
+        for (int i = 1; i < n; i++) {
+            T key = a[i];
+            int j = i - 1;
+            while (j >= 0 && key < a[j]) {
+                a[j + 1] = a[j];
+                j--;
+            }
+            a[j + 1] = key;
+        }
+    }
+};
+
+// Сортирующая сеть из simd_sort.h для int (до 64 элементов при AVX2), иначе вставки
+struct NetworkBase {
+    static const char* name() { return "Network"; }
+
+    template <typename T>
+    static SORT_POLICY_INLINE void sort(T* a, int n) {
+        if constexpr (std::is_same<T, int>::value) {
+            if (n <= SimdSort::kMaxNetwork) {
+                SimdSort::sortSmall(a, n);
+                return;
+            }
+        }
+        InsertionBase::sort(a, n);
+    }
+};
+
+// ---- Запасной алгоритм при превышении глубины 2 * log2(n) ----
+
+struct HeapFallback {
+    static const char* name() { return "Heap"; }
+    static const bool enabled = true;
+
+    template <typename T>
+    static void sort(T* a, int n) {
+        std::make_heap(a, a + n);
+        std::sort_heap(a, a + n);
+    }
+};
+
+// Без ограничения глубины: на неудачных данных - O(n^2)
+struct NoFallback {
+    static const char* name() { return "None"; }
+    static const bool enabled = false;
+
+    template <typename T>
+    static void sort(T*, int) {}
+};
+
+// ---- Сборки ----
+
+template <typename Pivot, typename Partition, typename BaseCase, int Cutoff, typename Fallback>
+class PolicyQuickSort {
+    static_assert(Cutoff >= 1, "Cutoff must be positive");
+
+public:
+    template <typename T, typename Alloc>
+    static void sort(std::vector<T, Alloc>& arr) {
+        const int n = static_cast<int>(arr.size());
+        if (n <= 1) return;
+        int depthLimit = 0;
+        for (int size = n; size > 1; size >>= 1) depthLimit += 2;
+        sortRange(arr.data(), 0, n - 1, depthLimit);
+    }
+
+    static std::string name() {
+        return std::string("Quick/") + Pivot::name() + "/" + Partition::name() + "/" + BaseCase::name() +
+               "/" + std::to_string(Cutoff) + "/" + Fallback::name();
+    }
+
+private:
+    // Рекурсия в меньшую часть, цикл по большей: глубина стека O(log n) и без запасного алгоритма
+    template <typename T>
+    static void sortRange(T* a, int low, int high, int depthLimit) {
+        while (high - low + 1 > Cutoff) {
+            if constexpr (Fallback::enabled) {
+                if (depthLimit-- == 0) {
+                    Fallback::sort(a + low, high - low + 1);
+                    return;
+                }
+            }
+            PartitionSplit split = Partition::partition(a, low, high, Pivot::select(a, low, high));
+            if (split.leftHigh - low < high - split.rightLow) {
+                sortRange(a, low, split.leftHigh, depthLimit);
+                low = split.rightLow;
+            } else {
+                sortRange(a, split.rightLow, high, depthLimit);
+                high = split.leftHigh;
+            }
+        }
+        if (high > low) {
+            BaseCase::sort(a + low, high - low + 1);
+        }
+    }
+};
+
+// Устойчива, если устойчив базовый случай (InsertionBase; NetworkBase - только для int,
+// где равные элементы неразличимы)
+template <typename BaseCase, int Cutoff>
+class PolicyMergeSort {
+    static_assert(Cutoff >= 1, "Cutoff must be positive");
+
+public:
+    template <typename T, typename Alloc>
+    static void sort(std::vector<T, Alloc>& arr) {
+        const int n = static_cast<int>(arr.size());
+        if (n <= 1) return;
+        std::vector<T, Alloc> buffer(arr.size(), arr.get_allocator());
+        sortRange(arr.data(), buffer.data(), 0, n - 1);
+    }
+
+    static std::string name() {
+        return std::string("Merge/") + BaseCase::name() + "/" + std::to_string(Cutoff);
+    }
+
+private:
+    template <typename T>
+    static void sortRange(T* a, T* buffer, int low, int high) {
+        if (high - low + 1 <= Cutoff) {
+            BaseCase::sort(a + low, high - low + 1);
+            return;
+        }
+        int mid = low + (high - low) / 2;
+        sortRange(a, buffer, low, mid);
+        sortRange(a, buffer, mid + 1, high);
+        if (!(a[mid + 1] < a[mid])) {
+            return; // Половины уже по порядку
+        }
+        int i = low, j = mid + 1, k = low;
+        while (i <= mid && j <= high) {
+            buffer[k++] = a[j] < a[i] ? a[j++] : a[i++];
+        }
+        while (i <= mid) buffer[k++] = a[i++];
+        while (j <= high) buffer[k++] = a[j++];
+        std::copy(buffer + low, buffer + high + 1, a + low);
+    }
+};
+
+#endif
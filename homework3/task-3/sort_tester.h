@@ -3,11 +3,27 @@
 
 #include <vector>
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <type_traits>
+#include "alloc_telemetry.h"
+#include "background_worker.h"
 #include "sort_algorithms.h"
 #include "data_generator.h"
+#include "result_history.h"
+
+// Запись с ключом и исходной позицией. Сравнивается только по ключу,
+// поэтому по index видно, сохранила ли сортировка порядок равных ключей
+struct TaggedKey {
+    int key;
+    int index;
+
+    bool operator<(const TaggedKey& other) const { return key < other.key; }
+};
 
 class SortTester {
 private:
@@ -17,6 +33,9 @@ private:
         int size;
         double timeMs;
         bool sortedCorrectly;
+        bool permutationPreserved; // То же мультимножество элементов, что и на входе
+        std::string stable;        // "true", "false" или "n/a" (сортировка только для int)
+        AllocTelemetry::Stats memory; // Выделения памяти самой сортировкой
     };
 
     std::vector<TestResult> results;
@@ -34,6 +53,116 @@ private:
         return std::vector<int>(original);
     }
 
+    // Отпечаток мультимножества: сумма и xor перемешанных значений не зависят
+    // от порядка, а случайно совпасть у разных наборов практически не могут
+    struct MultisetHash {
+        uint64_t sum = 0;
+        uint64_t xorValue = 0;
+        size_t count = 0;
+
+        bool operator==(const MultisetHash& other) const {
+            return sum == other.sum && xorValue == other.xorValue && count == other.count;
+        }
+    };
+
+    static uint64_t mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    static MultisetHash multisetHash(const std::vector<int>& arr) {
+        MultisetHash hash;
+        for (int value : arr) {
+            uint64_t h = mix(static_cast<uint32_t>(value));
+            hash.sum += h;
+            hash.xorValue ^= h;
+        }
+        hash.count = arr.size();
+        return hash;
+    }
+
+    // Устойчивость: сортируем записи (ключ, исходный индекс) и проверяем, что
+    // равные ключи идут по возрастанию индекса. Ключи огрубляются делением,
+    // чтобы повторы были в любом типе данных, а сама форма данных сохранилась
+    template<typename SortFunction>
+    static std::string checkStability(SortFunction& sortFunc, const std::vector<int>& originalData) {
+        if constexpr (std::is_invocable<SortFunction&, std::vector<TaggedKey>&>::value) {
+            std::vector<TaggedKey> tagged(originalData.size());
+            for (size_t i = 0; i < originalData.size(); i++) {
+                tagged[i] = {originalData[i] / 16, static_cast<int>(i)};
+            }
+            sortFunc(tagged);
+            for (size_t i = 1; i < tagged.size(); i++) {
+                if (tagged[i].key < tagged[i - 1].key) {
+                    return "false";
+                }
+                if (tagged[i].key == tagged[i - 1].key && tagged[i].index < tagged[i - 1].index) {
+                    return "false";
+                }
+            }
+            return "true";
+        } else {
+            return "n/a";
+        }
+    }
+
+    // Замер одной сортировки. Копия входа делается до начала отсчета,
+    // чтение RSS для учета памяти - вне отсчета
+    template<typename SortFunction>
+    static double timeSort(SortFunction& sortFunc, std::vector<int>& data, AllocTelemetry::Stats& memory) {
+        AllocTelemetry::Scope scope;
+        auto start = std::chrono::high_resolution_clock::now();
+        
+        sortFunc(data);
+        
+        auto end = std::chrono::high_resolution_clock::now();
+        memory = scope.finish();
+        
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        return duration.count() / 1000.0;
+    }
+
+    // Проверка готового массива: сама сортировка не вызывается, можно в фоновом потоке
+    static void verifyOutput(TestResult& result, const std::vector<int>& originalData,
+                             const std::vector<int>& sortedData) {
+        result.sortedCorrectly = isSorted(sortedData);
+        result.permutationPreserved = multisetHash(sortedData) == multisetHash(originalData);
+    }
+
+    // Проверки результата - вне замера времени
+    template<typename SortFunction>
+    static void verify(TestResult& result, SortFunction& sortFunc,
+                       const std::vector<int>& originalData, const std::vector<int>& sortedData) {
+        verifyOutput(result, originalData, sortedData);
+        result.stable = checkStability(sortFunc, originalData);
+    }
+
+    // Замер в основном потоке, проверка и запись результата - в фоновом.
+    // results во время прогона меняет только verifier, поэтому порядок строк сохраняется.
+    // Проверка устойчивости заново запускает сортировку, поэтому идет в основном потоке
+    // между замерами: быстрые сортировки берут опорные через rand() с общей блокировкой
+    // и общим состоянием, параллельный прогон мешал бы замеру и менял бы его опорные
+    template<typename SortFunction>
+    double testPipelined(BackgroundWorker& verifier, SortFunction sortFunc, const std::string& algoName,
+                         const std::shared_ptr<const std::vector<int>>& originalData, const std::string& dataType) {
+        auto testData = std::make_shared<std::vector<int>>(*originalData);
+        TestResult result;
+        double timeMs = timeSort(sortFunc, *testData, result.memory);
+
+        result.algorithm = algoName;
+        result.dataType = dataType;
+        result.size = originalData->size();
+        result.timeMs = timeMs;
+        result.stable = checkStability(sortFunc, *originalData);
+        verifier.submit([this, result, originalData, testData]() mutable {
+            verifyOutput(result, *originalData, *testData);
+            results.push_back(result);
+        });
+        return timeMs;
+    }
+
 public:
     template<typename SortFunction>
     TestResult testAlgorithm(SortFunction sortFunc, const std::string& algoName, 
@@ -44,22 +173,16 @@ public:
         result.size = originalData.size();
 
         std::vector<int> testData = copyArray(originalData);
-
-        auto start = std::chrono::high_resolution_clock::now();
-        
-        sortFunc(testData);
-        
-        auto end = std::chrono::high_resolution_clock::now();
-        
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-        result.timeMs = duration.count() / 1000.0;
-        
-        result.sortedCorrectly = isSorted(testData);
+        result.timeMs = timeSort(sortFunc, testData, result.memory);
+        verify(result, sortFunc, originalData, testData);
 
         return result;
     }
 
-    // Запуск всех тестов
+    // Запуск всех тестов конвейером: пока основной поток (на отдельном ядре) замеряет
+    // сортировки текущего набора данных, один фоновый поток генерирует следующий набор,
+    // другой проверяет уже отсортированные массивы. Замеры при этом не пересекаются
+    // друг с другом, а ожидание генерации и проверок уходит из общего времени прогона
     void runAllTests(const std::vector<int>& sizes = {100, 500, 1000, 5000, 10000, 50000, 100000}) {
         std::cout << "Starting performance tests..." << std::endl;
         
@@ -75,55 +198,99 @@ public:
             "RANDOM", "SORTED", "REVERSED", "NEARLY_SORTED", "FEW_UNIQUE"
         };
 
-        for (int size : sizes) {
-            std::cout << "Testing size: " << size << std::endl;
-            
-            for (size_t i = 0; i < dataTypes.size(); i++) {
-                // Генерируем тестовые данные
-                std::vector<int> testData = DataGenerator::generateData(size, dataTypes[i]);
-                
-                // Тестируем стандартный Quick Sort
-                auto result1 = testAlgorithm(
-                    [](std::vector<int>& arr) { SortAlgorithms::quickSortStandard(arr); },
-                    "QuickSort_Standard",
-                    testData,
-                    dataTypeNames[i]
-                );
-                results.push_back(result1);
-
-                // Тестируем гибридный Introsort
-                auto result2 = testAlgorithm(
-                    [](std::vector<int>& arr) { SortAlgorithms::quickSortHybrid(arr); },
-                    "QuickSort_Hybrid", 
-                    testData,
-                    dataTypeNames[i]
-                );
-                results.push_back(result2);
-
-                std::cout << "  " << dataTypeNames[i] 
-                          << " - Standard: " << result1.timeMs << "ms"
-                          << ", Hybrid: " << result2.timeMs << "ms"
-                          << std::endl;
+        // Привязка снимается после остановки фоновых потоков, при выходе из runAllTests
+        BackgroundWorker::ScopedPin pin(BackgroundWorker::measurementCore());
+        BackgroundWorker generator(BackgroundWorker::backgroundCore(0));
+        BackgroundWorker verifier(BackgroundWorker::backgroundCore(1));
+
+        // Набор данных с номером job: size = sizes[job / типов], тип = job % типов
+        const size_t jobCount = sizes.size() * dataTypes.size();
+        auto generateAsync = [&](size_t job) {
+            int size = sizes[job / dataTypes.size()];
+            DataGenerator::DataType type = dataTypes[job % dataTypes.size()];
+            auto task = std::make_shared<std::packaged_task<std::vector<int>()>>(
+                [size, type] { return DataGenerator::generateData(size, type); });
+            std::future<std::vector<int>> future = task->get_future();
+            generator.submit([task] { (*task)(); });
+            return future;
+        };
+
+        std::future<std::vector<int>> next = generateAsync(0);
+        for (size_t job = 0; job < jobCount; job++) {
+            size_t i = job % dataTypes.size();
+            if (i == 0) {
+                std::cout << "Testing size: " << sizes[job / dataTypes.size()] << std::endl;
             }
+
+            auto testData = std::make_shared<const std::vector<int>>(next.get());
+            if (job + 1 < jobCount) {
+                next = generateAsync(job + 1);
+            }
+            
+            // Тестируем стандартный Quick Sort
+            double time1 = testPipelined(verifier,
+                [](auto& arr) { SortAlgorithms::quickSortStandard(arr); },
+                "QuickSort_Standard", testData, dataTypeNames[i]);
+
+            // Тестируем гибридный Introsort
+            double time2 = testPipelined(verifier,
+                [](auto& arr) { SortAlgorithms::quickSortHybrid(arr); },
+                "QuickSort_Hybrid", testData, dataTypeNames[i]);
+
+            // Тестируем векторную быструю сортировку
+            double time3 = testPipelined(verifier,
+                [](std::vector<int>& arr) { SortAlgorithms::quickSortVectorized(arr); },
+                "QuickSort_Vectorized", testData, dataTypeNames[i]);
+
+            // Тестируем устойчивый Merge Sort
+            double time4 = testPipelined(verifier,
+                [](auto& arr) { SortAlgorithms::mergeSort(arr); },
+                "MergeSort_Stable", testData, dataTypeNames[i]);
+
+            std::cout << "  " << dataTypeNames[i] 
+                      << " - Standard: " << time1 << "ms"
+                      << ", Hybrid: " << time2 << "ms"
+                      << ", Vectorized: " << time3 << "ms"
+                      << ", Merge: " << time4 << "ms"
+                      << std::endl;
         }
+        verifier.wait();
     }
 
+    // Строки results пишет только конвейер runAllTests. RSS - на весь процесс, и во время
+    // замера его меняют генератор и проверка, поэтому изменения RSS в таблице нет;
+    // счетчики выделений свои у каждого потока и остаются
     void saveResultsToCSV(const std::string& filename) {
         std::ofstream file(filename);
-        file << "Algorithm,DataType,Size,TimeMs,Correct\n";
+        file << "Algorithm,DataType,Size,TimeMs,Correct,Permutation,Stable,"
+             << "Allocations,AllocatedBytes,PeakExtraBytes\n";
         
         for (const auto& result : results) {
             file << result.algorithm << ","
                  << result.dataType << ","
                  << result.size << ","
                  << result.timeMs << ","
-                 << (result.sortedCorrectly ? "true" : "false") << "\n";
+                 << (result.sortedCorrectly ? "true" : "false") << ","
+                 << (result.permutationPreserved ? "true" : "false") << ","
+                 << result.stable << ","
+                 << result.memory.allocations << ","
+                 << result.memory.bytes << ","
+                 << result.memory.peakBytes << "\n";
         }
         
         file.close();
         std::cout << "Results saved to: " << filename << std::endl;
     }
 
+    // Времена прогона - в общую историю замеров (result_history.h)
+    void saveResultsToHistory(const std::string& driver) {
+        ResultHistory history(driver);
+        for (const auto& result : results) {
+            history.add(result.algorithm, result.dataType, result.size, result.timeMs * 1e6);
+        }
+        history.save();
+    }
+
     // Вывод сводки результатов
     void printSummary() {
         std::cout << "\n=== TEST RESULTS SUMMARY ===" << std::endl;
@@ -132,7 +299,10 @@ public:
             std::cout << result.algorithm << " - " << result.dataType 
                       << " (n=" << result.size << "): " 
                       << result.timeMs << "ms - "
-                      << (result.sortedCorrectly ? "PASS" : "FAIL") << std::endl;
+                      << (result.sortedCorrectly && result.permutationPreserved ? "PASS" : "FAIL")
+                      << " (stable: " << result.stable
+                      << ", allocations: " << result.memory.allocations
+                      << ", peak extra: " << result.memory.peakBytes << " bytes)" << std::endl;
         }
     }
 
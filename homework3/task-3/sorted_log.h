@@ -0,0 +1,169 @@
+#ifndef SORTED_LOG_H
+#define SORTED_LOG_H
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "simd_sort.h"
+#include "sort_algorithms.h"
+
+// Отсортированная коллекция (мультимножество) для потока мелких добавлений с редкими чтениями,
+// устроенная как LSM-дерево:
+//  - insert только дописывает ключ в неотсортированный буфер;
+//  - полный буфер сортируется (SortAlgorithms::sort) и становится отсортированной серией;
+//  - серии лежат по уровням: на уровне i - не больше одной серии длиной до bufferSize * 2^i.
+//    Новая серия сливается с занятым уровнем и переносится выше, как перенос в двоичном
+//    счетчике. Каждый ключ сливается O(log(n / bufferSize)) раз - в сумме столько же
+//    работы, сколько одна сортировка всего массива, но без пересортировки после каждой пачки;
+//  - чтение сначала сбрасывает буфер в серию (короткая серия сливается только с короткими),
+//    затем ищет бинарным поиском в каждом уровне: O(log^2 n) на запрос.
+// Чтения логически константны: сброс буфера меняет только внутреннее представление
+template <typename T>
+class SortedLog {
+public:
+    explicit SortedLog(std::size_t bufferSize = 1 << 16)
+        : bufferSize(bufferSize > 0 ? bufferSize : 1), total(0) {
+        buffer.reserve(this->bufferSize);
+    }
+
+    void insert(const T& key) {
+        buffer.push_back(key);
+        total++;
+        if (buffer.size() >= bufferSize) {
+            flush();
+        }
+    }
+
+    template <typename InputIt>
+    void insert_range(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    std::size_t size() const { return total; }
+
+    bool empty() const { return total == 0; }
+
+    // Число непустых уровней (отсортированных серий) после сброса буфера
+    std::size_t runs() const {
+        flush();
+        std::size_t count = 0;
+        for (const std::vector<T>& level : levels) {
+            count += !level.empty();
+        }
+        return count;
+    }
+
+    bool contains(const T& key) const {
+        flush();
+        for (const std::vector<T>& level : levels) {
+            if (std::binary_search(level.begin(), level.end(), key)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t count(const T& key) const {
+        flush();
+        std::size_t result = 0;
+        for (const std::vector<T>& level : levels) {
+            auto range = std::equal_range(level.begin(), level.end(), key);
+            result += range.second - range.first;
+        }
+        return result;
+    }
+
+    // Сколько ключей строго меньше key
+    std::size_t rank(const T& key) const {
+        flush();
+        std::size_t result = 0;
+        for (const std::vector<T>& level : levels) {
+            result += std::lower_bound(level.begin(), level.end(), key) - level.begin();
+        }
+        return result;
+    }
+
+    // Все ключи по возрастанию: уровни сливаются в одну серию, она остается
+    // на своем уровне до следующих вставок
+    const std::vector<T>& sorted() const {
+        flush();
+        std::vector<T> all;
+        for (std::vector<T>& level : levels) {
+            if (level.empty()) continue;
+            all = all.empty() ? std::move(level) : mergeRuns(level, all);
+            level = std::vector<T>();
+        }
+        levels.clear();
+        std::size_t index = levelOf(all.size());
+        levels.resize(index + 1);
+        levels[index] = std::move(all);
+        return levels[index];
+    }
+
+    void clear() {
+        buffer.clear();
+        levels.clear();
+        spare = std::vector<T>();
+        total = 0;
+    }
+
+private:
+    std::size_t bufferSize;
+    std::size_t total;
+    mutable std::vector<T> buffer;              // Неотсортированные последние вставки
+    mutable std::vector<std::vector<T>> levels; // levels[i] - пусто или одна серия
+    mutable std::vector<T> spare;               // Память под результат следующего слияния
+
+    // Наименьший уровень, вмещающий серию: size <= bufferSize * 2^i
+    std::size_t levelOf(std::size_t size) const {
+        std::size_t index = 0;
+        while ((bufferSize << index) < size) index++;
+        return index;
+    }
+
+    // Буфер -> серия -> перенос по уровням
+    void flush() const {
+        if (buffer.empty()) return;
+        std::vector<T> run;
+        run.swap(buffer);
+        buffer.reserve(bufferSize);
+        SortAlgorithms::sort(run);
+
+        std::size_t index = levelOf(run.size());
+        while (index < levels.size() && !levels[index].empty()) {
+            mergeInto(levels[index], run, spare);
+            run.swap(spare);
+            // Освободившаяся серия уровня - буфер для следующего слияния: ее страницы
+            // уже отображены, новое выделение каждый раз стоило бы page fault на 4 КБ
+            spare.swap(levels[index]);
+            levels[index] = std::vector<T>();
+            index = std::max(index + 1, levelOf(run.size()));
+        }
+        if (index >= levels.size()) {
+            levels.resize(index + 1);
+        }
+        levels[index] = std::move(run);
+    }
+
+    static std::vector<T> mergeRuns(const std::vector<T>& a, const std::vector<T>& b) {
+        std::vector<T> out;
+        mergeInto(a, b, out);
+        return out;
+    }
+
+    // Слияние двух серий тем же кодом, что и в naturalMergeSort
+    static void mergeInto(const std::vector<T>& a, const std::vector<T>& b, std::vector<T>& out) {
+        out.resize(a.size() + b.size());
+        if constexpr (std::is_same<T, int>::value) {
+            SimdSort::mergeRuns(a.data(), static_cast<int>(a.size()), b.data(), static_cast<int>(b.size()),
+                                out.data());
+        } else {
+            std::merge(a.begin(), a.end(), b.begin(), b.end(), out.begin());
+        }
+    }
+};
+
+#endif
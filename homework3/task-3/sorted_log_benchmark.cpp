@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+#include "result_history.h"
+#include "sort_algorithms.h"
+#include "sorted_log.h"
+
+// Поток вставок с редкими чтениями: после каждой пачки из batch ключей - один поиск.
+// Сравниваются:
+//  - Append: только push_back (нижняя граница, коллекция не отсортирована);
+//  - AppendSortOnce: push_back и одна SortAlgorithms::sort в конце (чтений нет);
+//  - ResortEachBatch: push_back и quickSortHybrid всего массива после каждой пачки;
+//  - Multiset: std::multiset, вставка по одному узлу;
+//  - SortedLog: sorted_log.h.
+// Запуск: ./SortedLogBenchmark [maxSize] [batch], по умолчанию 10^7 и 10^5.
+// Результаты: sorted_log_results.csv и общая история замеров (result_history.h),
+// в истории тип данных - BATCH_<batch>
+
+using Clock = std::chrono::steady_clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    long long maxSize = argc > 1 ? std::atoll(argv[1]) : 10000000;
+    int batch = argc > 2 ? std::atoi(argv[2]) : 100000;
+
+    ResultHistory history("SortedLogBenchmark");
+    const std::string pattern = "BATCH_" + std::to_string(batch);
+    std::ofstream csv("sorted_log_results.csv");
+    csv << "Container,Size,Batch,TimeMs,NsPerInsert,RelativeToAppend,RelativeToAppendSortOnce,Correct\n";
+
+    std::cout << "=== SORTED COLLECTION UNDER APPENDS (one lookup per " << batch << " inserts) ===" << std::endl;
+    for (long long n = 100000; n <= maxSize; n *= 10) {
+        std::mt19937 gen(42);
+        std::vector<int> keys(n);
+        for (int& key : keys) key = static_cast<int>(gen());
+        std::vector<int> expected = keys;
+        std::sort(expected.begin(), expected.end());
+
+        long long found = 0; // Чтобы поиски не выбросил оптимизатор
+
+        auto start = Clock::now();
+        std::vector<int> appended;
+        for (long long i = 0; i < n; i++) appended.push_back(keys[i]);
+        double appendMs = msSince(start);
+        found += appended.size();
+
+        start = Clock::now();
+        std::vector<int> sortedOnce;
+        for (long long i = 0; i < n; i++) sortedOnce.push_back(keys[i]);
+        SortAlgorithms::sort(sortedOnce);
+        double sortOnceMs = msSince(start);
+        bool sortOnceCorrect = sortedOnce == expected;
+
+        // Пересортировка - O(n^2 log n / batch): только на небольших размерах
+        double resortMs = -1;
+        bool resortCorrect = true;
+        if (n <= 1000000) {
+            start = Clock::now();
+            std::vector<int> resorted;
+            for (long long i = 0; i < n; i++) {
+                resorted.push_back(keys[i]);
+                if ((i + 1) % batch == 0 || i + 1 == n) {
+                    SortAlgorithms::quickSortHybrid(resorted);
+                    found += std::binary_search(resorted.begin(), resorted.end(), keys[i / 2]);
+                }
+            }
+            resortMs = msSince(start);
+            resortCorrect = resorted == expected;
+        }
+
+        start = Clock::now();
+        std::multiset<int> tree;
+        for (long long i = 0; i < n; i++) {
+            tree.insert(keys[i]);
+            if ((i + 1) % batch == 0) found += tree.count(keys[i / 2]);
+        }
+        double treeMs = msSince(start);
+        bool treeCorrect = std::equal(tree.begin(), tree.end(), expected.begin());
+
+        start = Clock::now();
+        SortedLog<int> log;
+        for (long long i = 0; i < n; i++) {
+            log.insert(keys[i]);
+            if ((i + 1) % batch == 0) found += log.contains(keys[i / 2]);
+        }
+        double logMs = msSince(start);
+        bool logCorrect = log.sorted() == expected && log.contains(keys[n / 3]) &&
+                          log.count(expected[0]) == static_cast<size_t>(std::count(expected.begin(), expected.end(), expected[0]));
+
+        struct Row {
+            const char* name;
+            double ms;
+            bool correct;
+        } rows[] = {
+            {"Append", appendMs, true},
+            {"AppendSortOnce", sortOnceMs, sortOnceCorrect},
+            {"ResortEachBatch", resortMs, resortCorrect},
+            {"Multiset", treeMs, treeCorrect},
+            {"SortedLog", logMs, logCorrect},
+        };
+
+        std::cout << "Size: " << n << " (" << found % 2 << ")" << std::endl;
+        for (const Row& row : rows) {
+            if (row.ms < 0) {
+                std::cout << "  " << row.name << ": skipped" << std::endl;
+                continue;
+            }
+            double nsPerInsert = row.ms * 1e6 / n;
+            std::cout << "  " << row.name << ": " << row.ms << "ms, " << nsPerInsert << " ns/insert, x"
+                      << row.ms / appendMs << " of Append, x" << row.ms / sortOnceMs << " of AppendSortOnce"
+                      << (row.correct ? "" : " FAIL") << std::endl;
+            csv << row.name << "," << n << "," << batch << "," << row.ms << "," << nsPerInsert << ","
+                << row.ms / appendMs << "," << row.ms / sortOnceMs << "," << (row.correct ? "true" : "false") << "\n";
+            history.add(row.name, pattern, n, row.ms * 1e6);
+        }
+    }
+    std::cout << "Results saved to 'sorted_log_results.csv'" << std::endl;
+    history.save();
+    return 0;
+}
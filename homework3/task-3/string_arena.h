@@ -0,0 +1,68 @@
+#ifndef STRING_ARENA_H
+#define STRING_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Набор строк без выделения памяти на каждую строку: байты всех строк лежат подряд
+// в bytes, строка i - отрезок [offsets[i], offsets[i + 1]). Строки не обязаны
+// заканчиваться нулем и могут содержать нулевые байты
+class StringArena {
+public:
+    StringArena() : offsets(1, 0) {}
+
+    void reserve(std::size_t count, std::size_t totalBytes) {
+        offsets.reserve(count + 1);
+        bytes.reserve(totalBytes);
+    }
+
+    // Смещения 32-битные: текст арены не длиннее 4 ГБ. data может указывать в саму арену
+    // (повтор уже добавленной строки) - тогда копируется после возможного переноса байтов
+    void add(const char* data, std::size_t length) {
+        const std::size_t end = bytes.size();
+        if (length > UINT32_MAX - end) {
+            throw std::length_error("StringArena: text exceeds 4 GiB");
+        }
+        std::less<const char*> before;
+        bool inside = length > 0 && !before(data, bytes.data()) && before(data, bytes.data() + end);
+        std::size_t from = inside ? static_cast<std::size_t>(data - bytes.data()) : 0;
+        bytes.resize(end + length);
+        if (length > 0) {
+            std::memcpy(bytes.data() + end, inside ? bytes.data() + from : data, length);
+        }
+        offsets.push_back(static_cast<uint32_t>(end + length));
+    }
+
+    void add(std::string_view s) { add(s.data(), s.size()); }
+
+    std::size_t size() const { return offsets.size() - 1; }
+
+    std::size_t byteSize() const { return bytes.size(); }
+
+    uint32_t offset(std::size_t i) const { return offsets[i]; }
+
+    uint32_t length(std::size_t i) const { return offsets[i + 1] - offsets[i]; }
+
+    std::string_view operator[](std::size_t i) const {
+        return std::string_view(bytes.data() + offsets[i], length(i));
+    }
+
+    const char* data() const { return bytes.data(); }
+
+    void clear() {
+        bytes.clear();
+        offsets.assign(1, 0);
+    }
+
+private:
+    std::vector<char> bytes;
+    std::vector<uint32_t> offsets; // size() + 1 границ, offsets[0] = 0
+};
+
+#endif
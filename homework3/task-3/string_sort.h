@@ -0,0 +1,452 @@
+#ifndef STRING_SORT_H
+#define STRING_SORT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "string_arena.h"
+
+// Сортировка строк из StringArena в лексикографическом порядке байтов (как std::string).
+// Сортируется массив ключей (смещение, длина), байты в арене не двигаются.
+// Сравнение строк целиком (std::sort) на каждом шаге заново проходит общий префикс;
+// алгоритмы ниже смотрят на каждый байт префикса O(1) раз на строку:
+//  - multikeyQuickSort: трехчастное разбиение по одному байту на глубине depth
+//    (Бентли-Седжвик), равные опорному байту переходят к следующему байту;
+//  - msdRadixSort: поразрядная сортировка со старших байтов. Байты текущего разряда
+//    сначала одним последовательным проходом копируются в кэш-массив, подсчет и
+//    раскладка читают только его, а не разбросанные по арене строки. На больших
+//    группах разряд - два байта сразу (алфавит 257^2), на малых - multikeyQuickSort;
+//  - lcpMergeSort: слияние, которое хранит LCP (длину общего префикса) соседних строк
+//    и при слиянии сравнивает строки только начиная с известного общего префикса;
+//  - parallelLcpMergeSort: части массива сортируются msdRadixSort в отдельных потоках,
+//    затем попарно сливаются LCP-слиянием (пары одного уровня - параллельно).
+// Конец строки - "символ" 0, байт b - символ b + 1: строка-префикс идет раньше продолжений
+class StringSort {
+public:
+    // Строка арены: 8 байт, как указатель
+    struct Key {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    static std::vector<Key> keysOf(const StringArena& arena) {
+        std::vector<Key> keys(arena.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            keys[i] = {arena.offset(i), arena.length(i)};
+        }
+        return keys;
+    }
+
+    static std::string_view view(const StringArena& arena, Key key) {
+        return std::string_view(arena.data() + key.offset, key.length);
+    }
+
+    // Эталон: std::sort со сравнением строк с первого байта
+    static void comparisonSort(const StringArena& arena, std::vector<Key>& keys) {
+        const char* text = arena.data();
+        std::sort(keys.begin(), keys.end(), [text](Key a, Key b) {
+            return std::string_view(text + a.offset, a.length) < std::string_view(text + b.offset, b.length);
+        });
+    }
+
+    static void multikeyQuickSort(const StringArena& arena, std::vector<Key>& keys) {
+        multikeyQuickSort(bytesOf(arena), keys.data(), keys.size(), 0);
+    }
+
+    static void msdRadixSort(const StringArena& arena, std::vector<Key>& keys) {
+        std::vector<Key> buffer(keys.size());
+        std::vector<uint32_t> cache(keys.size());
+        msdRadix(bytesOf(arena), keys.data(), buffer.data(), cache.data(), keys.size(), 0);
+    }
+
+    // Устойчива
+    static void lcpMergeSort(const StringArena& arena, std::vector<Key>& keys) {
+        const size_t n = keys.size();
+        std::vector<uint32_t> lcp(n);
+        std::vector<Key> bufferKeys(n);
+        std::vector<uint32_t> bufferLcp(n);
+        lcpMergeSortRange(bytesOf(arena), keys.data(), lcp.data(), bufferKeys.data(), bufferLcp.data(), n);
+    }
+
+    // threads = 0 - по числу ядер. Части короче kMinParallelPart не делятся
+    static void parallelLcpMergeSort(const StringArena& arena, std::vector<Key>& keys, unsigned threads = 0) {
+        const unsigned char* text = bytesOf(arena);
+        const size_t n = keys.size();
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        size_t parts = std::min<size_t>(threads, std::max<size_t>(1, n / kMinParallelPart));
+
+        std::vector<Key> buffer(n);
+        std::vector<uint32_t> cache(n);
+        std::vector<uint32_t> lcp(n);
+        std::vector<uint32_t> bufferLcp(n);
+        std::vector<size_t> bounds(parts + 1);
+        for (size_t p = 0; p <= parts; p++) {
+            bounds[p] = n * p / parts;
+        }
+
+        // Части: поразрядная сортировка и LCP соседей, каждая часть - в своем потоке
+        runParallel(parts, [&](size_t p) {
+            size_t begin = bounds[p], count = bounds[p + 1] - begin;
+            msdRadix(text, keys.data() + begin, buffer.data() + begin, cache.data() + begin, count, 0);
+            fillLcp(text, keys.data() + begin, lcp.data() + begin, count);
+        });
+
+        // Дерево слияний: на каждом уровне пары соседних серий сливаются параллельно
+        Key* from = keys.data();
+        Key* to = buffer.data();
+        uint32_t* fromLcp = lcp.data();
+        uint32_t* toLcp = bufferLcp.data();
+        while (bounds.size() > 2) {
+            size_t runs = bounds.size() - 1;
+            runParallel((runs + 1) / 2, [&](size_t pair) {
+                size_t first = bounds[2 * pair], middle = bounds[std::min(2 * pair + 1, runs)];
+                size_t last = bounds[std::min(2 * pair + 2, runs)];
+                lcpMerge(text, from + first, fromLcp + first, middle - first, from + middle, fromLcp + middle,
+                         last - middle, to + first, toLcp + first);
+            });
+            std::vector<size_t> merged;
+            for (size_t i = 0; i < bounds.size(); i += 2) {
+                merged.push_back(bounds[i]);
+            }
+            if (merged.back() != n) {
+                merged.push_back(n);
+            }
+            bounds.swap(merged);
+            std::swap(from, to);
+            std::swap(fromLcp, toLcp);
+        }
+        if (from != keys.data()) {
+            std::copy(from, from + n, keys.data());
+        }
+    }
+
+    // lcp[i] - длина общего префикса keys[i - 1] и keys[i], lcp[0] = 0
+    static std::vector<uint32_t> lcpArray(const StringArena& arena, const std::vector<Key>& keys) {
+        std::vector<uint32_t> lcp(keys.size());
+        fillLcp(bytesOf(arena), keys.data(), lcp.data(), keys.size());
+        return lcp;
+    }
+
+    static bool isSorted(const StringArena& arena, const std::vector<Key>& keys) {
+        for (size_t i = 1; i < keys.size(); i++) {
+            if (view(arena, keys[i]) < view(arena, keys[i - 1])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Новая арена со строками в порядке keys: дальнейшие проходы по ней последовательны
+    static StringArena gather(const StringArena& arena, const std::vector<Key>& keys) {
+        StringArena result;
+        result.reserve(keys.size(), arena.byteSize());
+        for (Key key : keys) {
+            result.add(arena.data() + key.offset, key.length);
+        }
+        return result;
+    }
+
+private:
+    static const size_t kInsertionThreshold = 16;    // Меньше - вставками со сравнением от depth
+    static const size_t kRadixThreshold = 256;       // Меньше - multikeyQuickSort
+    static const size_t kSuperAlphabetThreshold = 1 << 16; // Больше - разряд из двух байтов
+    static const size_t kMinParallelPart = 1 << 14;
+    static const uint32_t kAlphabet = 257;           // Конец строки + 256 байтов
+
+    static const unsigned char* bytesOf(const StringArena& arena) {
+        return reinterpret_cast<const unsigned char*>(arena.data());
+    }
+
+    static uint32_t charAt(const unsigned char* text, Key key, uint32_t depth) {
+        return depth < key.length ? text[key.offset + depth] + 1u : 0u;
+    }
+
+    // Длина общего префикса, начиная с from (байты до from уже известны равными).
+    // По 8 байт за сравнение: первый различающийся байт - младший ненулевой в xor
+    static uint32_t commonPrefix(const unsigned char* text, Key a, Key b, uint32_t from) {
+        const uint32_t limit = std::min(a.length, b.length);
+        const unsigned char* x = text + a.offset;
+        const unsigned char* y = text + b.offset;
+        uint32_t i = from;
+        while (i + 8 <= limit) {
+            uint64_t wx, wy;
+            std::memcpy(&wx, x + i, 8);
+            std::memcpy(&wy, y + i, 8);
+            if (wx != wy) {
+#if defined(__GNUC__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                return i + static_cast<uint32_t>(__builtin_ctzll(wx ^ wy) / 8);
+#else
+                break;
+#endif
+            }
+            i += 8;
+        }
+        while (i < limit && x[i] == y[i]) i++;
+        return i;
+    }
+
+    // a < b при известном общем префиксе длины depth
+    static bool lessFrom(const unsigned char* text, Key a, Key b, uint32_t depth) {
+        uint32_t h = commonPrefix(text, a, b, depth);
+        return charAt(text, a, h) < charAt(text, b, h);
+    }
+
+    static void insertionSort(const unsigned char* text, Key* a, size_t n, uint32_t depth) {
+        for (size_t i = 1; i < n; i++) {
+            Key key = a[i];
+            size_t j = i;
+            while (j > 0 && lessFrom(text, key, a[j - 1], depth)) {
+                a[j] = a[j - 1];
+                j--;
+            }
+            a[j] = key;
+        }
+    }
+
+    // Общий префикс всей группы (все строки уже совпадают до depth): один проход
+    // по 8 байт вместо прохода по группе на каждый байт длинного общего префикса
+    static uint32_t groupPrefix(const unsigned char* text, const Key* a, size_t n, uint32_t depth) {
+        uint32_t h = a[0].length;
+        for (size_t i = 1; i < n && h > depth; i++) {
+            h = std::min(h, commonPrefix(text, a[0], a[i], depth));
+        }
+        return std::max(h, depth);
+    }
+
+    static void fillLcp(const unsigned char* text, const Key* a, uint32_t* lcp, size_t n) {
+        if (n == 0) return;
+        lcp[0] = 0;
+        for (size_t i = 1; i < n; i++) {
+            lcp[i] = commonPrefix(text, a[i - 1], a[i], 0);
+        }
+    }
+
+    // ---- Multikey quicksort ----
+
+    static uint32_t medianChar(const unsigned char* text, const Key* a, size_t n, uint32_t depth) {
+        uint32_t x = charAt(text, a[0], depth);
+        uint32_t y = charAt(text, a[n / 2], depth);
+        uint32_t z = charAt(text, a[n - 1], depth);
+        return std::max(std::min(x, y), std::min(std::max(x, y), z));
+    }
+
+    // Рекурсия в части "меньше" и "больше", цикл по части "равно" на следующем байте
+    static void multikeyQuickSort(const unsigned char* text, Key* a, size_t n, uint32_t depth) {
+        while (n > kInsertionThreshold) {
+            uint32_t pivot = medianChar(text, a, n, depth);
+            size_t lt = 0, i = 0, gt = n;
+            while (i < gt) {
+                uint32_t c = charAt(text, a[i], depth);
+                if (c < pivot) {
+                    std::swap(a[lt++], a[i++]);
+                } else if (c > pivot) {
+                    std::swap(a[i], a[--gt]);
+                } else {
+                    i++;
+                }
+            }
+            if (pivot == 0 && lt == 0 && gt == n) {
+                return; // Все строки закончились на depth - они одинаковы
+            }
+            if (lt == 0 && gt == n) {
+                depth = groupPrefix(text, a, n, depth + 1);
+                continue;
+            }
+            multikeyQuickSort(text, a, lt, depth);
+            multikeyQuickSort(text, a + gt, n - gt, depth);
+            if (pivot == 0) {
+                return; // Равные опорному закончились на depth - они одинаковы
+            }
+            a += lt;
+            n = gt - lt;
+            depth++;
+        }
+        insertionSort(text, a, n, depth);
+    }
+
+    // ---- MSD radix sort ----
+
+    // Группа строк a[begin, begin + n), совпадающих до depth
+    struct RadixGroup {
+        size_t begin;
+        size_t n;
+        uint32_t depth;
+    };
+
+    // Счетчики разряда: в куче и общие для всех групп одной сортировки
+    struct RadixCounters {
+        std::vector<size_t> count;
+        std::vector<size_t> start;
+    };
+
+    // Группы ждут в явном стеке, а не в рекурсии: цепочка ключей-префиксов друг друга
+    // ("a", "aa", "aaa", ...) дает новую группу на каждом байте глубины. Группы в стеке
+    // не пересекаются и в каждой не меньше двух строк, поэтому их не больше n / 2.
+    // Группа, где у всех один и тот же символ разряда, не раскладывается -
+    // сразу переходим к концу общего префикса группы
+    static void msdRadix(const unsigned char* text, Key* a, Key* buffer, uint32_t* cache, size_t n,
+                         uint32_t depth) {
+        std::vector<RadixGroup> pending;
+        pending.push_back({0, n, depth});
+        RadixCounters small{std::vector<size_t>(kAlphabet), std::vector<size_t>(kAlphabet)};
+        RadixCounters super;
+
+        while (!pending.empty()) {
+            RadixGroup group = pending.back();
+            pending.pop_back();
+            if (group.n < kRadixThreshold) {
+                multikeyQuickSort(text, a + group.begin, group.n, group.depth);
+                continue;
+            }
+            if (group.n >= kSuperAlphabetThreshold) {
+                if (super.count.empty()) {
+                    super.count.resize(kAlphabet * kAlphabet);
+                    super.start.resize(kAlphabet * kAlphabet);
+                }
+                radixPass(text, a, buffer, cache, group, 2, super, pending);
+            } else {
+                radixPass(text, a, buffer, cache, group, 1, small, pending);
+            }
+        }
+    }
+
+    // Символ разряда из width байтов: c0 (1 байт) или c0 * 257 + c1 (2 байта, алфавит 257^2 -
+    // на группах от kSuperAlphabetThreshold строк обход счетчиков окупается).
+    // Символ, кратный 257 (c1 = 0), или 0 - строка закончилась внутри разряда.
+    // Подгруппы кладутся в pending
+    static void radixPass(const unsigned char* text, Key* base, Key* bufferBase, uint32_t* cacheBase,
+                          RadixGroup group, uint32_t width, RadixCounters& counters,
+                          std::vector<RadixGroup>& pending) {
+        Key* a = base + group.begin;
+        Key* buffer = bufferBase + group.begin;
+        uint32_t* cache = cacheBase + group.begin;
+        const size_t n = group.n;
+        const uint32_t depth = group.depth;
+
+        for (size_t i = 0; i < n; i++) {
+            uint32_t c0 = charAt(text, a[i], depth);
+            cache[i] = width == 1 || c0 == 0 ? c0 : c0 * kAlphabet + charAt(text, a[i], depth + 1);
+        }
+        std::vector<size_t>& count = counters.count;
+        std::vector<size_t>& start = counters.start;
+        std::fill(count.begin(), count.end(), 0);
+        for (size_t i = 0; i < n; i++) {
+            count[cache[i]]++;
+        }
+
+        auto ended = [width](uint32_t c) { return width == 1 ? c == 0 : c % kAlphabet == 0; };
+        if (count[cache[0]] == n) {
+            if (!ended(cache[0])) {
+                pending.push_back({group.begin, n, groupPrefix(text, a, n, depth + width)});
+            }
+            return; // Иначе все строки закончились - они равны
+        }
+
+        size_t offset = 0;
+        for (size_t c = 0; c < count.size(); c++) {
+            start[c] = offset;
+            offset += count[c];
+        }
+        for (size_t i = 0; i < n; i++) {
+            buffer[start[cache[i]]++] = a[i];
+        }
+        std::copy(buffer, buffer + n, a);
+
+        offset = group.begin;
+        for (size_t c = 0; c < count.size(); c++) {
+            if (count[c] > 1 && !ended(static_cast<uint32_t>(c))) {
+                pending.push_back({offset, count[c], depth + width});
+            }
+            offset += count[c];
+        }
+    }
+
+    // ---- LCP merge sort ----
+
+    // Слияние двух отсортированных серий с массивами LCP соседей.
+    // ha, hb - LCP текущих голов серий с последней выведенной строкой. Голова
+    // с большим LCP меньше, и строки сравниваются только при ha == hb - начиная с ha.
+    // При равенстве берется строка из a: слияние устойчиво
+    static void lcpMerge(const unsigned char* text, const Key* a, const uint32_t* lcpA, size_t na, const Key* b,
+                         const uint32_t* lcpB, size_t nb, Key* out, uint32_t* outLcp) {
+        size_t i = 0, j = 0, k = 0;
+        uint32_t ha = 0, hb = 0;
+        while (i < na && j < nb) {
+            if (ha > hb) {
+                out[k] = a[i];
+                outLcp[k++] = ha;
+                ha = ++i < na ? lcpA[i] : 0;
+            } else if (ha < hb) {
+                out[k] = b[j];
+                outLcp[k++] = hb;
+                hb = ++j < nb ? lcpB[j] : 0;
+            } else {
+                uint32_t h = commonPrefix(text, a[i], b[j], ha);
+                if (charAt(text, a[i], h) <= charAt(text, b[j], h)) {
+                    out[k] = a[i];
+                    outLcp[k++] = ha;
+                    ha = ++i < na ? lcpA[i] : 0;
+                    hb = h;
+                } else {
+                    out[k] = b[j];
+                    outLcp[k++] = hb;
+                    hb = ++j < nb ? lcpB[j] : 0;
+                    ha = h;
+                }
+            }
+        }
+        if (i < na) {
+            out[k] = a[i];
+            outLcp[k++] = ha;
+            for (i++; i < na; i++, k++) {
+                out[k] = a[i];
+                outLcp[k] = lcpA[i];
+            }
+        }
+        if (j < nb) {
+            out[k] = b[j];
+            outLcp[k++] = hb;
+            for (j++; j < nb; j++, k++) {
+                out[k] = b[j];
+                outLcp[k] = lcpB[j];
+            }
+        }
+    }
+
+    static void lcpMergeSortRange(const unsigned char* text, Key* a, uint32_t* lcp, Key* bufferKeys,
+                                  uint32_t* bufferLcp, size_t n) {
+        if (n <= kInsertionThreshold) {
+            insertionSort(text, a, n, 0);
+            fillLcp(text, a, lcp, n);
+            return;
+        }
+        size_t mid = n / 2;
+        lcpMergeSortRange(text, a, lcp, bufferKeys, bufferLcp, mid);
+        lcpMergeSortRange(text, a + mid, lcp + mid, bufferKeys + mid, bufferLcp + mid, n - mid);
+        lcpMerge(text, a, lcp, mid, a + mid, lcp + mid, n - mid, bufferKeys, bufferLcp);
+        std::copy(bufferKeys, bufferKeys + n, a);
+        std::copy(bufferLcp, bufferLcp + n, lcp);
+    }
+
+    // Задачи 0..count-1, последняя - в вызывающем потоке
+    template <typename Task>
+    static void runParallel(size_t count, Task task) {
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i + 1 < count; i++) {
+            workers.emplace_back(task, i);
+        }
+        if (count > 0) {
+            task(count - 1);
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+};
+
+#endif
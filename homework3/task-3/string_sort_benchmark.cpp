@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "data_generator.h"
+#include "result_history.h"
+#include "string_sort.h"
+
+// Сортировка строковых ключей (string_sort.h) на наборах StringDataGenerator.
+// Эталоны: std::sort по std::vector<std::string> (строка - отдельное выделение памяти)
+// и std::sort по ключам арены со сравнением string_view.
+// В консоль выводится и средний LCP соседей в отсортированном порядке: сколько байт
+// общего префикса сравнение строк целиком проходит заново.
+// Запуск: ./StringSortBenchmark [maxSize] [threads], по умолчанию 10^6 и число ядер.
+// Результаты: string_sort_results.csv и общая история замеров (result_history.h)
+
+using Key = StringSort::Key;
+
+double bestMs(const std::vector<Key>& original, std::vector<Key>& result, int runs,
+              void (*sort)(const StringArena&, std::vector<Key>&), const StringArena& arena) {
+    double best = 1e18;
+    for (int run = 0; run < runs; run++) {
+        result = original;
+        auto start = std::chrono::steady_clock::now();
+        sort(arena, result);
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+bool sameOrder(const StringArena& arena, const std::vector<Key>& keys, const std::vector<Key>& reference) {
+    if (keys.size() != reference.size()) return false;
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (StringSort::view(arena, keys[i]) != StringSort::view(arena, reference[i])) return false;
+    }
+    return true;
+}
+
+static unsigned threadCount = 0;
+
+void parallelSort(const StringArena& arena, std::vector<Key>& keys) {
+    StringSort::parallelLcpMergeSort(arena, keys, threadCount);
+}
+
+int main(int argc, char** argv) {
+    int maxSize = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    threadCount = argc > 2 ? std::atoi(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    const int runs = 3;
+
+    const StringDataGenerator::DataType dataTypes[] = {
+        StringDataGenerator::RANDOM, StringDataGenerator::URLS, StringDataGenerator::SHARED_PREFIX,
+        StringDataGenerator::FEW_UNIQUE, StringDataGenerator::PREFIX_CHAIN
+    };
+
+    struct Algorithm {
+        const char* name;
+        void (*sort)(const StringArena&, std::vector<Key>&);
+    } algorithms[] = {
+        {"StdSortArena", StringSort::comparisonSort},
+        {"MultikeyQuickSort", StringSort::multikeyQuickSort},
+        {"MsdRadixSort", StringSort::msdRadixSort},
+        {"LcpMergeSort", StringSort::lcpMergeSort},
+        {"ParallelLcpMergeSort", parallelSort},
+    };
+
+    ResultHistory history("StringSortBenchmark");
+    std::ofstream csv("string_sort_results.csv");
+    csv << "Algorithm,DataType,Size,Threads,TimeMs,RelativeToStdSortStrings,Correct\n";
+
+    std::cout << "=== STRING SORTING (" << threadCount << " threads for ParallelLcpMergeSort) ===" << std::endl;
+    for (int size = 10000; size <= maxSize; size *= 10) {
+        for (StringDataGenerator::DataType type : dataTypes) {
+            const char* typeName = StringDataGenerator::name(type);
+            StringArena arena = StringDataGenerator::generateData(size, type);
+            std::vector<Key> original = StringSort::keysOf(arena);
+
+            // Эталон с выделением памяти на каждую строку
+            std::vector<std::string> strings(size);
+            for (int i = 0; i < size; i++) {
+                strings[i] = std::string(arena[i]);
+            }
+            double stringsMs = 1e18;
+            for (int run = 0; run < runs; run++) {
+                std::vector<std::string> copy = strings;
+                auto start = std::chrono::steady_clock::now();
+                std::sort(copy.begin(), copy.end());
+                auto end = std::chrono::steady_clock::now();
+                stringsMs = std::min(stringsMs, std::chrono::duration<double, std::milli>(end - start).count());
+            }
+
+            std::vector<Key> reference = original;
+            StringSort::comparisonSort(arena, reference);
+            std::vector<uint32_t> lcp = StringSort::lcpArray(arena, reference);
+            double averageLcp = 0;
+            for (uint32_t h : lcp) averageLcp += h;
+            averageLcp /= size;
+
+            std::cout << typeName << ", n = " << size << " (" << arena.byteSize() / size
+                      << " bytes per key, mean LCP " << averageLcp << ")" << std::endl;
+            std::cout << "  StdSortStrings: " << stringsMs << "ms" << std::endl;
+            csv << "StdSortStrings," << typeName << "," << size << ",1," << stringsMs << ",1,true\n";
+            history.add("StdSortStrings", typeName, size, stringsMs * 1e6);
+
+            std::vector<Key> result;
+            for (const Algorithm& algorithm : algorithms) {
+                double ms = bestMs(original, result, runs, algorithm.sort, arena);
+                bool correct = sameOrder(arena, result, reference);
+                int threads = algorithm.sort == parallelSort ? threadCount : 1;
+                std::cout << "  " << algorithm.name << ": " << ms << "ms, x" << stringsMs / ms
+                          << " vs std::sort(strings)" << (correct ? "" : " FAIL") << std::endl;
+                csv << algorithm.name << "," << typeName << "," << size << "," << threads << "," << ms << ","
+                    << ms / stringsMs << "," << (correct ? "true" : "false") << "\n";
+                history.add(algorithm.name, typeName, size, ms * 1e6);
+            }
+        }
+    }
+    std::cout << "Results saved to 'string_sort_results.csv'" << std::endl;
+    history.save();
+    return 0;
+}
@@ -0,0 +1,384 @@
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include "node_arena.h"
+
+// B+-дерево с тем же интерфейсом insert/find/Iterator, что и BinarySearchTree.
+//  - ключи внутреннего узла занимают одну кэш-линию (16 int - 17 детей), поэтому на
+//    спуск приходится по одному промаху на уровень при высоте log_17(n);
+//  - все ключи лежат в листьях: отсортированные массивы по 4 кэш-линии, связанные
+//    в двусвязный список. Итератор идет по массиву и переходит к соседнему листу,
+//    без подъемов по родителям, как в BinarySearchTree::Iterator;
+//  - узлы в slab-аренах (node_arena.h), связи - 32-битные индексы, уничтожение -
+//    освобождение арен без рекурсии;
+//  - вставка в конец дерева (ключи по возрастанию) делит узлы не пополам, а начинает
+//    новый правый узел: листья и внутренние узлы остаются заполненными.
+// Дубликаты игнорируются, удаления нет
+template <typename T>
+class BPlusTree {
+public:
+    static constexpr int kInnerKeys = 64 / sizeof(T) >= 3 ? static_cast<int>(64 / sizeof(T)) : 3;
+    static constexpr int kLeafKeys = 256 / sizeof(T) >= 4 ? static_cast<int>(256 / sizeof(T)) : 4;
+
+private:
+    struct alignas(64) Inner {
+        T keys[kInnerKeys];                // keys[i] - наименьший ключ поддерева children[i + 1]
+        NodeIndex children[kInnerKeys + 1];
+        int count;                         // Число ключей, детей на один больше
+    };
+
+    struct alignas(64) Leaf {
+        T keys[kLeafKeys];
+        NodeIndex prev;
+        NodeIndex next;
+        int count;
+
+        Leaf() : prev(NIL), next(NIL), count(0) {}
+    };
+
+public:
+    BPlusTree() : root(NIL), first(NIL), last(NIL), height(0), total(0) {}
+
+    BPlusTree(BPlusTree&& other) noexcept
+        : root(other.root), first(other.first), last(other.last), height(other.height), total(other.total),
+          inners(std::move(other.inners)), leaves(std::move(other.leaves)) {
+        other.reset();
+    }
+
+    BPlusTree& operator=(BPlusTree&& other) noexcept {
+        if (this != &other) {
+            root = other.root;
+            first = other.first;
+            last = other.last;
+            height = other.height;
+            total = other.total;
+            inners = std::move(other.inners);
+            leaves = std::move(other.leaves);
+            other.reset();
+        }
+        return *this;
+    }
+
+    ~BPlusTree() = default;
+
+    void insert(const T& key) {
+        if (root == NIL) {
+            root = first = last = leaves.allocate();
+            leaves[root].keys[0] = key;
+            leaves[root].count = 1;
+            total = 1;
+            return;
+        }
+
+        // Спуск с запоминанием пути: родительских ссылок у узлов нет
+        PathEntry path[kMaxHeight];
+        NodeIndex node = root;
+        for (int level = 0; level < height; level++) {
+            const Inner& inner = inners[node];
+            int slot = static_cast<int>(std::upper_bound(inner.keys, inner.keys + inner.count, key) - inner.keys);
+            path[level] = {node, slot};
+            node = inner.children[slot];
+        }
+
+        Leaf& leaf = leaves[node];
+        int pos = static_cast<int>(std::lower_bound(leaf.keys, leaf.keys + leaf.count, key) - leaf.keys);
+        if (pos < leaf.count && !(key < leaf.keys[pos])) {
+            return; // Дубликаты игнорируем
+        }
+        total++;
+        if (leaf.count < kLeafKeys) {
+            std::copy_backward(leaf.keys + pos, leaf.keys + leaf.count, leaf.keys + leaf.count + 1);
+            leaf.keys[pos] = key;
+            leaf.count++;
+            return;
+        }
+
+        bool append = pos == kLeafKeys && leaf.next == NIL;
+        NodeIndex right = splitLeaf(node, pos, key);
+        insertIntoParents(path, leaves[right].keys[0], right, append);
+    }
+
+    // Пакетная вставка: по возрастанию ключи идут в конец листа, листья заполняются целиком
+    template <typename InputIt>
+    void insert_range(InputIt firstKey, InputIt lastKey) {
+        std::vector<T> keys(firstKey, lastKey);
+        std::sort(keys.begin(), keys.end());
+        for (const T& key : keys) {
+            insert(key);
+        }
+    }
+
+    // Освобождение всех узлов без обхода дерева
+    void clear() {
+        inners.clear();
+        leaves.clear();
+        reset();
+    }
+
+    std::size_t size() const { return total; }
+
+    bool empty() const { return total == 0; }
+
+    // Число уровней внутренних узлов над листьями
+    int depth() const { return height; }
+
+    // Двунаправленный итератор: позиция в листе
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterator(const BPlusTree* tree, NodeIndex leaf, int pos) : tree(tree), leaf(leaf), pos(pos) {}
+
+        Iterator& operator++() {
+            if (leaf != NIL) {
+                const Leaf& node = tree->leaves[leaf];
+                if (++pos == node.count) {
+                    leaf = node.next;
+                    pos = 0;
+                }
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        // Из end() - на последний ключ
+        Iterator& operator--() {
+            if (leaf == NIL) {
+                leaf = tree->last;
+                pos = leaf == NIL ? 0 : tree->leaves[leaf].count - 1;
+            } else if (pos > 0) {
+                pos--;
+            } else {
+                leaf = tree->leaves[leaf].prev;
+                pos = leaf == NIL ? 0 : tree->leaves[leaf].count - 1;
+            }
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator temp = *this;
+            --(*this);
+            return temp;
+        }
+
+        // Ключ менять нельзя - это сломает порядок в дереве
+        const T& operator*() const {
+            if (leaf == NIL) {
+                throw std::runtime_error("Dereferencing end iterator");
+            }
+            return tree->leaves[leaf].keys[pos];
+        }
+
+        const T* operator->() const { return &**this; }
+
+        bool operator==(const Iterator& other) const { return leaf == other.leaf && pos == other.pos; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        const BPlusTree* tree;
+        NodeIndex leaf; // NIL - конец
+        int pos;
+    };
+
+    Iterator begin() const { return Iterator(this, first, 0); }
+
+    Iterator end() const { return Iterator(this, NIL, 0); }
+
+    Iterator find(const T& key) const {
+        Iterator it = lower_bound(key);
+        return (it != end() && !(key < *it)) ? it : end();
+    }
+
+    // Первый ключ >= key
+    Iterator lower_bound(const T& key) const {
+        if (root == NIL) return end();
+        NodeIndex leaf = descend(key);
+        const Leaf& node = leaves[leaf];
+        int pos = static_cast<int>(std::lower_bound(node.keys, node.keys + node.count, key) - node.keys);
+        return at(leaf, pos);
+    }
+
+    // Первый ключ > key
+    Iterator upper_bound(const T& key) const {
+        if (root == NIL) return end();
+        NodeIndex leaf = descend(key);
+        const Leaf& node = leaves[leaf];
+        int pos = static_cast<int>(std::upper_bound(node.keys, node.keys + node.count, key) - node.keys);
+        return at(leaf, pos);
+    }
+
+    // Обход ключей из [lo, hi) прямо по массивам листьев, без итератора
+    template <typename Visitor>
+    void scan(const T& lo, const T& hi, Visitor visit) const {
+        if (root == NIL) return;
+        NodeIndex leaf = descend(lo);
+        const Leaf* node = &leaves[leaf];
+        int pos = static_cast<int>(std::lower_bound(node->keys, node->keys + node->count, lo) - node->keys);
+        while (true) {
+            for (; pos < node->count; pos++) {
+                if (!(node->keys[pos] < hi)) return;
+                visit(node->keys[pos]);
+            }
+            if (node->next == NIL) return;
+            node = &leaves[node->next];
+            pos = 0;
+        }
+    }
+
+private:
+    // После деления во внутреннем узле не меньше двух детей: 32 уровня вмещают 2^32 листьев
+    static constexpr int kMaxHeight = 32;
+
+    struct PathEntry {
+        NodeIndex node;
+        int slot; // В какого ребенка спустились
+    };
+
+    NodeIndex root;
+    NodeIndex first; // Самый левый лист - begin()
+    NodeIndex last;  // Самый правый лист - для --end()
+    int height;
+    std::size_t total;
+    SlabArena<Inner> inners;
+    SlabArena<Leaf> leaves;
+
+    void reset() {
+        root = first = last = NIL;
+        height = 0;
+        total = 0;
+    }
+
+    NodeIndex descend(const T& key) const {
+        NodeIndex node = root;
+        for (int level = 0; level < height; level++) {
+            const Inner& inner = inners[node];
+            node = inner.children[std::upper_bound(inner.keys, inner.keys + inner.count, key) - inner.keys];
+        }
+        return node;
+    }
+
+    // Позиция pos за концом листа - это начало следующего
+    Iterator at(NodeIndex leaf, int pos) const {
+        if (pos == leaves[leaf].count) {
+            return Iterator(this, leaves[leaf].next, 0);
+        }
+        return Iterator(this, leaf, pos);
+    }
+
+    // Делит полный лист, вставляя key в позицию pos; возвращает новый правый лист
+    NodeIndex splitLeaf(NodeIndex node, int pos, const T& key) {
+        NodeIndex right = leaves.allocate(); // Адреса узлов арены не меняются
+        Leaf& left = leaves[node];
+        Leaf& created = leaves[right];
+
+        created.prev = node;
+        created.next = left.next;
+        if (left.next != NIL) {
+            leaves[left.next].prev = right;
+        } else {
+            last = right;
+        }
+        left.next = right;
+
+        if (pos == kLeafKeys && created.next == NIL) {
+            // Дописывание в конец дерева: старый лист остается полным
+            created.keys[0] = key;
+            created.count = 1;
+            return right;
+        }
+
+        // Полный лист + новый ключ = kLeafKeys + 1 ключей, слева половина
+        T merged[kLeafKeys + 1];
+        std::copy(left.keys, left.keys + pos, merged);
+        merged[pos] = key;
+        std::copy(left.keys + pos, left.keys + kLeafKeys, merged + pos + 1);
+        int leftCount = (kLeafKeys + 1) / 2;
+        std::copy(merged, merged + leftCount, left.keys);
+        std::copy(merged + leftCount, merged + kLeafKeys + 1, created.keys);
+        left.count = leftCount;
+        created.count = kLeafKeys + 1 - leftCount;
+        return right;
+    }
+
+    // Вставка разделителя и нового правого ребенка вверх по пути, с делением полных узлов.
+    // append - дописывание в конец дерева: полный узел не делится пополам, новый
+    // правый узел начинается с одного ребенка
+    void insertIntoParents(const PathEntry* path, T separator, NodeIndex right, bool append) {
+        for (int level = height - 1; level >= 0; level--) {
+            NodeIndex node = path[level].node;
+            int slot = path[level].slot;
+            Inner& inner = inners[node];
+            if (inner.count < kInnerKeys) {
+                std::copy_backward(inner.keys + slot, inner.keys + inner.count, inner.keys + inner.count + 1);
+                std::copy_backward(inner.children + slot + 1, inner.children + inner.count + 1,
+                                   inner.children + inner.count + 2);
+                inner.keys[slot] = separator;
+                inner.children[slot + 1] = right;
+                inner.count++;
+                return;
+            }
+
+            if (append && slot == kInnerKeys) {
+                NodeIndex sibling = inners.allocate();
+                inners[sibling].children[0] = right;
+                inners[sibling].count = 0;
+                right = sibling; // separator поднимается дальше без изменений
+                continue;
+            }
+
+            T keys[kInnerKeys + 1];
+            NodeIndex children[kInnerKeys + 2];
+            std::copy(inner.keys, inner.keys + slot, keys);
+            keys[slot] = separator;
+            std::copy(inner.keys + slot, inner.keys + kInnerKeys, keys + slot + 1);
+            std::copy(inner.children, inner.children + slot + 1, children);
+            children[slot + 1] = right;
+            std::copy(inner.children + slot + 1, inner.children + kInnerKeys + 1, children + slot + 2);
+
+            // Средний ключ уходит наверх и в узлах не остается
+            int leftCount = kInnerKeys / 2;
+            NodeIndex sibling = inners.allocate();
+            Inner& left = inners[node];
+            Inner& created = inners[sibling];
+            std::copy(keys, keys + leftCount, left.keys);
+            std::copy(children, children + leftCount + 1, left.children);
+            left.count = leftCount;
+            std::copy(keys + leftCount + 1, keys + kInnerKeys + 1, created.keys);
+            std::copy(children + leftCount + 1, children + kInnerKeys + 2, created.children);
+            created.count = kInnerKeys - leftCount;
+
+            separator = keys[leftCount];
+            right = sibling;
+        }
+
+        // Делился корень: дерево растет вверх
+        if (height == kMaxHeight) {
+            throw std::length_error("BPlusTree: too many levels");
+        }
+        NodeIndex newRoot = inners.allocate();
+        Inner& top = inners[newRoot];
+        top.keys[0] = separator;
+        top.children[0] = root;
+        top.children[1] = right;
+        top.count = 1;
+        root = newRoot;
+        height++;
+    }
+};
+
+#endif
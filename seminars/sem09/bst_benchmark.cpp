@@ -0,0 +1,481 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "binary_search_tree.h"
+#include "bplus_tree.h"
+#include "concurrent_bst.h"
+#include "static_search_index.h"
+
+// Сборка: g++ -std=c++17 -O2 -march=native -pthread bst_benchmark.cpp -o bst_benchmark
+
+namespace legacy {
+
+// Прежняя версия дерева: каждый узел через new, связи - указатели.
+// Оставлена только для сравнения производительности
+template <typename T>
+struct Node {
+    T key;
+    Node* left;
+    Node* right;
+    Node* parent;
+
+    Node(const T& k) : key(k), left(nullptr), right(nullptr), parent(nullptr) {}
+};
+
+template <typename T>
+class BinarySearchTree {
+public:
+    BinarySearchTree() : root(nullptr) {}
+    ~BinarySearchTree() { clear(root); }
+
+    void insert(const T& key) {
+        Node<T>** current = &root;
+        Node<T>* prev = nullptr;
+        while (*current) {
+            prev = *current;
+            if (key < (*current)->key) {
+                current = &(*current)->left;
+            } else if (key > (*current)->key) {
+                current = &(*current)->right;
+            } else {
+                return;
+            }
+        }
+        *current = new Node<T>(key);
+        (*current)->parent = prev;
+    }
+
+    // Обход в порядке возрастания через parent-ссылки, как в старом итераторе
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        Node<T>* current = root;
+        while (current && current->left) {
+            current = current->left;
+        }
+        while (current) {
+            visit(current->key);
+            if (current->right) {
+                current = current->right;
+                while (current->left) {
+                    current = current->left;
+                }
+            } else {
+                Node<T>* prev;
+                do {
+                    prev = current;
+                    current = current->parent;
+                } while (current && current->right == prev);
+            }
+        }
+    }
+
+private:
+    Node<T>* root;
+
+    void clear(Node<T>* node) {
+        if (node) {
+            clear(node->left);
+            clear(node->right);
+            delete node;
+        }
+    }
+};
+
+} // namespace legacy
+
+using Clock = std::chrono::high_resolution_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static std::vector<int> randomKeys(int n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(0, INT32_MAX);
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; i++) {
+        keys[i] = dist(gen);
+    }
+    return keys;
+}
+
+// Вставка и обход: старое дерево на указателях против дерева на slab-арене
+void benchmarkArena(const std::vector<int>& sizes) {
+    std::cout << "=== INSERT / ITERATE: pointer nodes vs slab arena ===" << std::endl;
+    std::cout << "N, legacy insert Mkeys/s, arena insert Mkeys/s, "
+              << "legacy iterate Mkeys/s, arena iterate Mkeys/s, legacy destroy ms, arena destroy ms"
+              << std::endl;
+
+    for (int n : sizes) {
+        std::vector<int> keys = randomKeys(n, 42);
+        long long checksum = 0;
+
+        auto* legacyTree = new legacy::BinarySearchTree<int>();
+        auto start = Clock::now();
+        for (int key : keys) legacyTree->insert(key);
+        double legacyInsert = secondsSince(start);
+
+        start = Clock::now();
+        legacyTree->forEach([&](int key) { checksum += key; });
+        double legacyIterate = secondsSince(start);
+
+        start = Clock::now();
+        delete legacyTree;
+        double legacyDestroy = secondsSince(start);
+
+        auto* arenaTree = new BinarySearchTree<int>();
+        start = Clock::now();
+        for (int key : keys) arenaTree->insert(key);
+        double arenaInsert = secondsSince(start);
+
+        start = Clock::now();
+        for (int key : *arenaTree) checksum -= key;
+        double arenaIterate = secondsSince(start);
+
+        start = Clock::now();
+        delete arenaTree;
+        double arenaDestroy = secondsSince(start);
+
+        std::cout << n << ", "
+                  << n / legacyInsert / 1e6 << ", " << n / arenaInsert / 1e6 << ", "
+                  << n / legacyIterate / 1e6 << ", " << n / arenaIterate / 1e6 << ", "
+                  << legacyDestroy * 1e3 << ", " << arenaDestroy * 1e3
+                  << (checksum == 0 ? "" : "  (CHECKSUM MISMATCH)") << std::endl;
+    }
+}
+
+// Порядок вставки ключей для экспериментов с балансировкой
+enum class InsertOrder { Sorted, Reversed, Random };
+
+static std::vector<int> orderedKeys(int n, InsertOrder order) {
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; i++) {
+        keys[i] = order == InsertOrder::Reversed ? n - i : i + 1;
+    }
+    if (order == InsertOrder::Random) {
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(7));
+    }
+    return keys;
+}
+
+// Среднее время одного find (нс) по случайным существующим ключам
+template <typename Tree>
+static double lookupLatencyNs(const Tree& tree, int n, long long& checksum) {
+    const int queries = 1000000;
+    std::vector<int> probes = randomKeys(queries, 13);
+    for (int& key : probes) {
+        key = key % n + 1;
+    }
+    auto start = Clock::now();
+    for (int key : probes) {
+        auto it = tree.find(key);
+        if (it != tree.end()) checksum += *it;
+    }
+    return secondsSince(start) * 1e9 / queries;
+}
+
+// Задержка find для обычного и AVL-дерева при разных порядках вставки
+void benchmarkBalancing(const std::vector<int>& sizes) {
+    std::cout << "\n=== FIND LATENCY: plain BST vs AVL ===" << std::endl;
+    std::cout << "N, order, plain ns/find, AVL ns/find" << std::endl;
+
+    const char* orderNames[] = {"SORTED", "REVERSED", "RANDOM"};
+    for (int n : sizes) {
+        for (InsertOrder order : {InsertOrder::Sorted, InsertOrder::Reversed, InsertOrder::Random}) {
+            std::vector<int> keys = orderedKeys(n, order);
+            long long checksum = 0;
+
+            // Вырожденное дерево строится за O(n^2): большие размеры пропускаем
+            std::string plain = "-";
+            if (order == InsertOrder::Random || n <= 30000) {
+                BinarySearchTree<int> tree;
+                for (int key : keys) tree.insert(key);
+                plain = std::to_string(lookupLatencyNs(tree, n, checksum));
+            }
+
+            AVLTree<int> avl;
+            for (int key : keys) avl.insert(key);
+            double balanced = lookupLatencyNs(avl, n, checksum);
+
+            std::cout << n << ", " << orderNames[static_cast<int>(order)] << ", "
+                      << plain << ", " << balanced << std::endl;
+        }
+    }
+}
+
+// Построение из отсортированных ключей и пакетная вставка против поштучной вставки
+void benchmarkBulkLoad(const std::vector<int>& sizes) {
+    std::cout << "\n=== BULK LOAD / BATCH INSERT ===" << std::endl;
+    std::cout << "N, AVL n*insert ms, build_from_sorted ms, "
+              << "plain n*insert (random batch) ms, insert_range (random batch) ms" << std::endl;
+
+    for (int n : sizes) {
+        std::vector<int> sorted = orderedKeys(n, InsertOrder::Sorted);
+        long long checksum = 0;
+
+        auto start = Clock::now();
+        AVLTree<int> avl;
+        for (int key : sorted) avl.insert(key);
+        double avlInsert = secondsSince(start);
+
+        start = Clock::now();
+        auto built = BinarySearchTree<int>::build_from_sorted(sorted.begin(), sorted.end());
+        double bulkBuild = secondsSince(start);
+        checksum += built.size() - avl.size();
+
+        // Половина ключей уже в дереве, вторая половина приходит пачкой
+        std::vector<int> keys = randomKeys(n, 42);
+        std::vector<int> base(keys.begin(), keys.begin() + n / 2);
+        std::vector<int> batch(keys.begin() + n / 2, keys.end());
+
+        BinarySearchTree<int> single;
+        single.insert_range(base.begin(), base.end());
+        start = Clock::now();
+        for (int key : batch) single.insert(key);
+        double singleInsert = secondsSince(start);
+
+        BinarySearchTree<int> batched;
+        batched.insert_range(base.begin(), base.end());
+        start = Clock::now();
+        batched.insert_range(batch.begin(), batch.end());
+        double batchInsert = secondsSince(start);
+        checksum += batched.size() - single.size();
+
+        std::cout << n << ", " << avlInsert * 1e3 << ", " << bulkBuild * 1e3 << ", "
+                  << singleInsert * 1e3 << ", " << batchInsert * 1e3
+                  << (checksum == 0 ? "" : "  (SIZE MISMATCH)") << std::endl;
+    }
+}
+
+// Среднее время одного запроса (нс) для произвольной функции поиска
+template <typename Lookup>
+static double queryLatencyNs(const std::vector<int>& probes, Lookup lookup, long long& checksum) {
+    auto start = Clock::now();
+    for (int key : probes) {
+        checksum += lookup(key);
+    }
+    return secondsSince(start) * 1e9 / probes.size();
+}
+
+// Статические индексы против BinarySearchTree::find и бинарного поиска по массиву
+void benchmarkStaticIndex(const std::vector<int>& sizes) {
+    std::cout << "\n=== LOOKUP: BinarySearchTree vs static indexes (ns/query) ===" << std::endl;
+    std::cout << "N, BST find, std::binary_search, Eytzinger, S-tree scalar, S-tree SIMD" << std::endl;
+
+    for (int n : sizes) {
+        std::vector<int> keys = randomKeys(n, 42);
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        std::vector<int> probes = randomKeys(1000000, 7);
+
+        auto tree = BinarySearchTree<int>::build_from_sorted(keys.begin(), keys.end());
+        EytzingerIndex<int> eytzinger(tree.begin(), tree.end());
+        STreeIndex stree(keys);
+        STreeIndex streeScalar(keys);
+        streeScalar.setSimd(false);
+
+        long long checksum[5] = {0, 0, 0, 0, 0};
+        double bst = queryLatencyNs(probes, [&](int x) { return tree.find(x) != tree.end(); }, checksum[0]);
+        double binary = queryLatencyNs(probes, [&](int x) {
+            return std::binary_search(keys.begin(), keys.end(), x);
+        }, checksum[1]);
+        double eyt = queryLatencyNs(probes, [&](int x) { return eytzinger.find(x) != eytzinger.end(); }, checksum[2]);
+        double scalar = queryLatencyNs(probes, [&](int x) { return streeScalar.find(x) != streeScalar.end(); }, checksum[3]);
+        double simd = queryLatencyNs(probes, [&](int x) { return stree.find(x) != stree.end(); }, checksum[4]);
+
+        bool consistent = true;
+        for (long long c : checksum) consistent = consistent && c == checksum[0];
+
+        std::cout << n << ", " << bst << ", " << binary << ", " << eyt << ", "
+                  << scalar << ", " << simd << (consistent ? "" : "  (RESULT MISMATCH)") << std::endl;
+    }
+}
+
+// Поиск по одному ключу против пакетного find_batch. Дерево строится вставками
+// в случайном порядке, поэтому соседние по спуску узлы разбросаны по памяти
+void benchmarkBatchFind(const std::vector<int>& sizes) {
+    std::cout << "\n=== BATCH FIND: find vs find_batch (Mlookups/s) ===" << std::endl;
+    std::cout << "N, find, find_batch, speedup" << std::endl;
+
+    for (int n : sizes) {
+        std::vector<int> keys = randomKeys(n, 42);
+        BinarySearchTree<int> tree;
+        tree.reserve(n);
+        for (int key : keys) tree.insert(key);
+
+        // Половина запросов - существующие ключи, половина - случайные
+        std::vector<int> probes = randomKeys(1000000, 7);
+        for (std::size_t i = 0; i < probes.size(); i += 2) {
+            probes[i] = keys[probes[i] % n];
+        }
+
+        long long single = 0, batched = 0;
+        auto start = Clock::now();
+        for (int key : probes) {
+            auto it = tree.find(key);
+            if (it != tree.end()) single += *it;
+        }
+        double singleTime = secondsSince(start);
+
+        start = Clock::now();
+        auto found = tree.find_batch(probes);
+        for (const auto& it : found) {
+            if (it != tree.end()) batched += *it;
+        }
+        double batchTime = secondsSince(start);
+
+        std::cout << n << ", " << probes.size() / singleTime / 1e6 << ", " << probes.size() / batchTime / 1e6
+                  << ", " << singleTime / batchTime << (single == batched ? "" : "  (RESULT MISMATCH)") << std::endl;
+    }
+}
+
+// Диапазонные обходы: итератор BinarySearchTree (подъемы по parent) против листьев B+-дерева.
+// Полный обход и 10^5 коротких обходов по 100 ключей от случайного существующего ключа
+template <typename Tree>
+static void scanThroughput(const Tree& tree, const std::vector<int>& starts, double& fullRate,
+                           double& rangeRate, long long& checksum) {
+    auto start = Clock::now();
+    for (int key : tree) checksum += key;
+    fullRate = tree.size() / secondsSince(start) / 1e6;
+
+    const int length = 100;
+    long long visited = 0;
+    start = Clock::now();
+    for (int key : starts) {
+        auto it = tree.find(key);
+        for (int i = 0; i < length && it != tree.end(); i++, ++it) {
+            checksum += *it;
+            visited++;
+        }
+    }
+    rangeRate = visited / secondsSince(start) / 1e6;
+}
+
+void benchmarkRangeScan(const std::vector<int>& sizes) {
+    std::cout << "\n=== RANGE SCAN: BinarySearchTree / AVLTree vs BPlusTree (Melements/s) ===" << std::endl;
+    std::cout << "N, BST insert Mkeys/s, B+ insert Mkeys/s, BST full scan, AVL full scan, B+ full scan, "
+              << "BST 100-key ranges, AVL 100-key ranges, B+ 100-key ranges, B+ scan() ~100-key ranges" << std::endl;
+
+    for (int n : sizes) {
+        std::vector<int> keys = randomKeys(n, 42);
+        std::vector<int> starts = randomKeys(100000, 9);
+        for (int& key : starts) key = keys[static_cast<std::size_t>(key) % n];
+
+        auto start = Clock::now();
+        BinarySearchTree<int> bst;
+        for (int key : keys) bst.insert(key);
+        double bstInsert = n / secondsSince(start) / 1e6;
+
+        AVLTree<int> avl;
+        for (int key : keys) avl.insert(key);
+
+        start = Clock::now();
+        BPlusTree<int> bplus;
+        for (int key : keys) bplus.insert(key);
+        double bplusInsert = n / secondsSince(start) / 1e6;
+
+        long long checksum[4] = {0, 0, 0, 0};
+        double full[3], ranges[3];
+        scanThroughput(bst, starts, full[0], ranges[0], checksum[0]);
+        scanThroughput(avl, starts, full[1], ranges[1], checksum[1]);
+        scanThroughput(bplus, starts, full[2], ranges[2], checksum[2]);
+
+        // scan по диапазону ключей, в котором в среднем 100 ключей (ключи равномерны в [0, 2^31))
+        long long span = 100LL * INT32_MAX / n;
+        long long visited = 0;
+        start = Clock::now();
+        for (int key : starts) {
+            int hi = static_cast<int>(std::min<long long>(INT32_MAX, key + span));
+            bplus.scan(key, hi, [&](int k) { checksum[3] += k; visited++; });
+        }
+        double scanRate = visited / secondsSince(start) / 1e6;
+
+        bool consistent = checksum[0] == checksum[1] && checksum[1] == checksum[2];
+        std::cout << n << ", " << bstInsert << ", " << bplusInsert << ", " << full[0] << ", " << full[1] << ", "
+                  << full[2] << ", " << ranges[0] << ", " << ranges[1] << ", " << ranges[2] << ", " << scanRate
+                  << (consistent ? "" : "  (RESULT MISMATCH)") << std::endl;
+    }
+}
+
+// Пропускная способность (Mops/s) смешанной нагрузки: 95% поиск, 5% вставка
+template <typename Operation>
+static double mixedThroughput(int threads, int opsPerThread, Operation operation) {
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([=] {
+            std::mt19937 gen(1000 + t);
+            for (int i = 0; i < opsPerThread; i++) {
+                unsigned r = gen();
+                operation(r % 100 < 5, static_cast<int>(r >> 8));
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    return static_cast<double>(threads) * opsPerThread / secondsSince(start) / 1e6;
+}
+
+// Дерево под глобальным мьютексом против дерева с чтением без блокировок
+void benchmarkConcurrent(int n) {
+    std::cout << "\n=== CONCURRENT 95/5 READ/WRITE (N=" << n << ", Mops/s) ===" << std::endl;
+    std::cout << "threads, mutex + AVLTree, ConcurrentBinarySearchTree" << std::endl;
+
+    std::vector<int> keys = randomKeys(n, 42);
+    int maxThreads = std::max(4u, std::thread::hardware_concurrency());
+    const int opsPerThread = 500000;
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        AVLTree<int> locked;
+        std::mutex mutex;
+        for (int key : keys) locked.insert(key);
+        double lockedRate = mixedThroughput(threads, opsPerThread, [&](bool write, int key) {
+            std::lock_guard<std::mutex> guard(mutex);
+            if (write) {
+                locked.insert(key);
+            } else {
+                volatile bool found = locked.find(key) != locked.end();
+                (void)found;
+            }
+        });
+
+        ConcurrentBinarySearchTree<int> concurrent;
+        for (int key : keys) concurrent.insert(key);
+        double concurrentRate = mixedThroughput(threads, opsPerThread, [&](bool write, int key) {
+            if (write) {
+                concurrent.insert(key);
+            } else {
+                volatile bool found = concurrent.contains(key);
+                (void)found;
+            }
+        });
+
+        std::cout << threads << ", " << lockedRate << ", " << concurrentRate << std::endl;
+    }
+}
+
+// Аргумент - максимальный размер. Для 10^8 ключей нужно около 4 ГБ памяти
+int main(int argc, char** argv) {
+    int maxSize = argc > 1 ? std::stoi(argv[1]) : 10000000;
+
+    std::vector<int> sizes;
+    for (int n = 1000; n <= maxSize; n *= 10) {
+        sizes.push_back(n);
+    }
+
+    benchmarkArena(sizes);
+    benchmarkBalancing(sizes);
+    benchmarkBulkLoad(sizes);
+    benchmarkStaticIndex(sizes);
+    benchmarkBatchFind(sizes);
+    benchmarkRangeScan(sizes);
+    benchmarkConcurrent(std::min(maxSize, 1000000));
+    return 0;
+}
@@ -0,0 +1,249 @@
+#ifndef CONCURRENT_BST_H
+#define CONCURRENT_BST_H
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "epoch_reclaimer.h"
+
+// Дерево поиска для многопоточного чтения.
+// Читатели не берут блокировок: загружают текущий корень и спускаются по нему.
+// Опубликованные узлы не меняются. Писатель (под мьютексом) копирует путь от корня
+// до места вставки, балансирует копию (AVL) и атомарно публикует новый корень.
+// Замененные узлы освобождаются через EpochReclaimer, когда их уже никто не читает.
+template <typename T>
+class ConcurrentBinarySearchTree {
+    struct Node {
+        T key;
+        Node* left;
+        Node* right;
+        int height;
+    };
+
+public:
+    // Итератор по снимку дерева. Родительских ссылок в неизменяемых узлах нет,
+    // поэтому путь хранится в стеке
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterator() = default;
+
+        Iterator& operator++() {
+            const Node* node = path.back();
+            path.pop_back();
+            pushLeft(node->right);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        const T& operator*() const {
+            if (path.empty()) {
+                throw std::runtime_error("Dereferencing end iterator");
+            }
+            return path.back()->key;
+        }
+
+        const T* operator->() const { return &**this; }
+
+        bool operator==(const Iterator& other) const {
+            return path.empty() ? other.path.empty()
+                                : !other.path.empty() && path.back() == other.path.back();
+        }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class ConcurrentBinarySearchTree;
+
+        // Вершина стека - текущий узел, ниже - предки, к которым вернемся
+        std::vector<const Node*> path;
+
+        void pushLeft(const Node* node) {
+            while (node) {
+                path.push_back(node);
+                node = node->left;
+            }
+        }
+    };
+
+    // Согласованный снимок дерева на момент создания. Пока снимок жив,
+    // его узлы не освобождаются, а параллельные вставки в нем не видны
+    class Snapshot {
+    public:
+        Iterator begin() const {
+            Iterator it;
+            it.pushLeft(root);
+            return it;
+        }
+
+        Iterator end() const { return Iterator(); }
+
+        Iterator find(const T& key) const {
+            Iterator it;
+            const Node* node = root;
+            while (node) {
+                if (key < node->key) {
+                    it.path.push_back(node);
+                    node = node->left;
+                } else if (node->key < key) {
+                    node = node->right;
+                } else {
+                    it.path.push_back(node);
+                    return it;
+                }
+            }
+            return end();
+        }
+
+    private:
+        friend class ConcurrentBinarySearchTree;
+
+        Snapshot(EpochReclaimer::Guard guard, const Node* root)
+            : guard(std::move(guard)), root(root) {}
+
+        EpochReclaimer::Guard guard;
+        const Node* root;
+    };
+
+    ConcurrentBinarySearchTree() : root(nullptr), count(0) {}
+    ConcurrentBinarySearchTree(const ConcurrentBinarySearchTree&) = delete;
+    ConcurrentBinarySearchTree& operator=(const ConcurrentBinarySearchTree&) = delete;
+
+    // Вызывать, когда другие потоки уже не работают с деревом
+    ~ConcurrentBinarySearchTree() {
+        std::vector<Node*> stack;
+        if (Node* node = root.load()) {
+            stack.push_back(node);
+        }
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+            if (node->left) stack.push_back(node->left);
+            if (node->right) stack.push_back(node->right);
+            delete node;
+        }
+    }
+
+    // Вставка ключа. Писатели сериализуются, читатели не ждут
+    void insert(const T& key) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        Node* current = root.load(std::memory_order_relaxed);
+        if (containsFrom(current, key)) {
+            return; // Дубликаты игнорируем
+        }
+        std::vector<Node*> replaced;
+        Node* updated = insertCopy(current, key, replaced);
+        root.store(updated, std::memory_order_seq_cst);
+        count.fetch_add(1, std::memory_order_relaxed);
+        for (Node* node : replaced) {
+            reclaimer.retire(node, [](void* p) { delete static_cast<Node*>(p); });
+        }
+    }
+
+    // Поиск без блокировок
+    bool contains(const T& key) const {
+        EpochReclaimer::Guard guard = reclaimer.pin();
+        return containsFrom(root.load(std::memory_order_seq_cst), key);
+    }
+
+    Snapshot snapshot() const {
+        EpochReclaimer::Guard guard = reclaimer.pin();
+        const Node* current = root.load(std::memory_order_seq_cst);
+        return Snapshot(std::move(guard), current);
+    }
+
+    std::size_t size() const { return count.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<Node*> root;
+    std::atomic<std::size_t> count;
+    std::mutex writeMutex;
+    mutable EpochReclaimer reclaimer;
+
+    static bool containsFrom(const Node* node, const T& key) {
+        while (node) {
+            if (key < node->key) {
+                node = node->left;
+            } else if (node->key < key) {
+                node = node->right;
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static int height(const Node* node) { return node ? node->height : 0; }
+
+    static void updateHeight(Node* node) {
+        int l = height(node->left);
+        int r = height(node->right);
+        node->height = (l > r ? l : r) + 1;
+    }
+
+    // Повороты трогают только свежие копии: тяжелая сторона всегда лежит на пути вставки
+    static Node* rotateLeft(Node* x) {
+        Node* y = x->right;
+        x->right = y->left;
+        y->left = x;
+        updateHeight(x);
+        updateHeight(y);
+        return y;
+    }
+
+    static Node* rotateRight(Node* x) {
+        Node* y = x->left;
+        x->left = y->right;
+        y->right = x;
+        updateHeight(x);
+        updateHeight(y);
+        return y;
+    }
+
+    static Node* rebalance(Node* node) {
+        updateHeight(node);
+        int balance = height(node->left) - height(node->right);
+        if (balance > 1) {
+            if (height(node->left->left) < height(node->left->right)) {
+                node->left = rotateLeft(node->left);
+            }
+            return rotateRight(node);
+        }
+        if (balance < -1) {
+            if (height(node->right->right) < height(node->right->left)) {
+                node->right = rotateRight(node->right);
+            }
+            return rotateLeft(node);
+        }
+        return node;
+    }
+
+    // Копирование пути: каждый узел на пути заменяется копией, оригиналы - в replaced
+    static Node* insertCopy(Node* node, const T& key, std::vector<Node*>& replaced) {
+        if (!node) {
+            return new Node{key, nullptr, nullptr, 1};
+        }
+        Node* copy = new Node(*node);
+        replaced.push_back(node);
+        if (key < node->key) {
+            copy->left = insertCopy(node->left, key, replaced);
+        } else {
+            copy->right = insertCopy(node->right, key, replaced);
+        }
+        return rebalance(copy);
+    }
+};
+
+#endif
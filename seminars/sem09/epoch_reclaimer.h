@@ -0,0 +1,150 @@
+#ifndef EPOCH_RECLAIMER_H
+#define EPOCH_RECLAIMER_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// Эпохальное освобождение памяти (epoch-based reclamation).
+// Читатель на время работы "закрепляет" текущую эпоху. Узел, снятый писателем
+// в эпоху E, удаляется только когда все закрепленные эпохи стали больше E:
+// значит, ни один читатель уже не может держать на него ссылку.
+class EpochReclaimer {
+public:
+    static constexpr int kMaxThreads = 128;
+
+    // RAII-защита читателя. Вложенные защиты одного потока разрешены
+    class Guard {
+    public:
+        explicit Guard(EpochReclaimer* owner) : owner(owner), slot(threadSlot()) {
+            Slot& s = owner->slots[slot];
+            if (s.depth++ == 0) {
+                // Устаревшая эпоха только делает освобождение осторожнее
+                s.epoch.store(owner->globalEpoch.load(), std::memory_order_seq_cst);
+            }
+        }
+
+        Guard(Guard&& other) noexcept : owner(other.owner), slot(other.slot) {
+            other.owner = nullptr;
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard& operator=(Guard&&) = delete;
+
+        ~Guard() {
+            if (owner) {
+                Slot& s = owner->slots[slot];
+                if (--s.depth == 0) {
+                    s.epoch.store(0, std::memory_order_release);
+                }
+            }
+        }
+
+    private:
+        EpochReclaimer* owner;
+        int slot;
+    };
+
+    EpochReclaimer() : globalEpoch(1) {}
+    EpochReclaimer(const EpochReclaimer&) = delete;
+    EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+    ~EpochReclaimer() {
+        for (Retired& r : retired) {
+            r.deleter(r.pointer);
+        }
+    }
+
+    Guard pin() { return Guard(this); }
+
+    // Отложенное удаление. Узел уже должен быть недостижим для новых читателей.
+    // Вызывается писателями по одному (под их общим мьютексом)
+    void retire(void* pointer, void (*deleter)(void*)) {
+        retired.push_back({pointer, deleter, globalEpoch.load()});
+        if (retired.size() >= kReclaimBatch) {
+            reclaim();
+        }
+    }
+
+    // Сдвинуть эпоху и удалить все, что уже никто не может читать
+    void reclaim() {
+        std::uint64_t current = globalEpoch.fetch_add(1) + 1;
+        std::uint64_t oldestActive = current;
+        for (const Slot& s : slots) {
+            std::uint64_t e = s.epoch.load(std::memory_order_seq_cst);
+            if (e != 0 && e < oldestActive) {
+                oldestActive = e;
+            }
+        }
+        std::size_t kept = 0;
+        for (Retired& r : retired) {
+            if (r.epoch < oldestActive) {
+                r.deleter(r.pointer);
+            } else {
+                retired[kept++] = r;
+            }
+        }
+        retired.resize(kept);
+    }
+
+    std::size_t pending() const { return retired.size(); }
+
+private:
+    static constexpr std::size_t kReclaimBatch = 1024;
+
+    // Слот на поток: эпоху пишет только владелец, читает писатель при освобождении
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> epoch{0};
+        int depth = 0;
+    };
+
+    struct Retired {
+        void* pointer;
+        void (*deleter)(void*);
+        std::uint64_t epoch;
+    };
+
+    Slot slots[kMaxThreads];
+    std::atomic<std::uint64_t> globalEpoch;
+    std::vector<Retired> retired;
+
+    // Номер слота потока. Номер возвращается в пул при завершении потока
+    static int threadSlot() {
+        struct Registry {
+            std::mutex mutex;
+            bool used[kMaxThreads] = {};
+        };
+        static Registry registry;
+
+        struct Holder {
+            int id = -1;
+            ~Holder() {
+                if (id >= 0) {
+                    std::lock_guard<std::mutex> lock(registry.mutex);
+                    registry.used[id] = false;
+                }
+            }
+        };
+        thread_local Holder holder;
+
+        if (holder.id < 0) {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            for (int i = 0; i < kMaxThreads; i++) {
+                if (!registry.used[i]) {
+                    registry.used[i] = true;
+                    holder.id = i;
+                    break;
+                }
+            }
+            if (holder.id < 0) {
+                throw std::runtime_error("EpochReclaimer: too many threads");
+            }
+        }
+        return holder.id;
+    }
+};
+
+#endif
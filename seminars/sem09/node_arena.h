@@ -0,0 +1,142 @@
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Индекс узла внутри арены: 32 бита вместо 64-битного указателя
+using NodeIndex = std::uint32_t;
+
+// "Нулевой" индекс (аналог nullptr). Узлов в арене не больше NIL: индекс NIL
+// совпал бы с "нулевым", а следующие пошли бы по кругу поверх живых узлов
+constexpr NodeIndex NIL = UINT32_MAX;
+
+// Интерфейс аллокатора узлов, который ожидает дерево:
+//   value_type                    - тип узла
+//   NodeIndex allocate(args...)   - создать узел и вернуть его индекс
+//   NodeT& operator[](NodeIndex)  - доступ к узлу по индексу
+//   std::size_t size() const      - сколько узлов создано
+//   void reserve(std::size_t)     - заранее выделить память
+//   void clear()                  - уничтожить все узлы разом
+
+// Slab-арена: узлы лежат подряд в блоках по 2^SlabBits штук.
+// Адреса узлов не меняются при росте, память отдается целыми блоками.
+template <typename NodeT, unsigned SlabBits = 12>
+class SlabArena {
+public:
+    using value_type = NodeT;
+    static constexpr std::size_t kSlabSize = std::size_t(1) << SlabBits;
+
+    SlabArena() : count(0) {}
+    SlabArena(const SlabArena&) = delete;
+    SlabArena& operator=(const SlabArena&) = delete;
+
+    SlabArena(SlabArena&& other) noexcept
+        : slabs(std::move(other.slabs)), count(other.count) {
+        other.count = 0;
+    }
+
+    SlabArena& operator=(SlabArena&& other) noexcept {
+        if (this != &other) {
+            clear();
+            slabs = std::move(other.slabs);
+            count = other.count;
+            other.count = 0;
+        }
+        return *this;
+    }
+
+    ~SlabArena() { clear(); }
+
+    template <typename... Args>
+    NodeIndex allocate(Args&&... args) {
+        if (count >= NIL) {
+            throw std::length_error("SlabArena: node count exceeds 32-bit index");
+        }
+        if ((count >> SlabBits) == slabs.size()) {
+            slabs.emplace_back(new Slot[kSlabSize]);
+        }
+        new (slot(count)) NodeT(std::forward<Args>(args)...);
+        return static_cast<NodeIndex>(count++);
+    }
+
+    NodeT& operator[](NodeIndex i) {
+        return *std::launder(reinterpret_cast<NodeT*>(slot(i)));
+    }
+
+    const NodeT& operator[](NodeIndex i) const {
+        return *std::launder(reinterpret_cast<const NodeT*>(
+            &slabs[i >> SlabBits][i & (kSlabSize - 1)]));
+    }
+
+    std::size_t size() const { return count; }
+
+    void reserve(std::size_t n) {
+        while (slabs.size() * kSlabSize < n) {
+            slabs.emplace_back(new Slot[kSlabSize]);
+        }
+    }
+
+    // Для тривиально разрушаемых узлов - O(1): блоки остаются для повторного использования
+    void clear() {
+        if constexpr (!std::is_trivially_destructible_v<NodeT>) {
+            for (std::size_t i = 0; i < count; i++) {
+                (*this)[static_cast<NodeIndex>(i)].~NodeT();
+            }
+        }
+        count = 0;
+    }
+
+    // Полностью вернуть память системе
+    void release() {
+        clear();
+        slabs.clear();
+    }
+
+private:
+    struct alignas(NodeT) Slot {
+        unsigned char bytes[sizeof(NodeT)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+    std::size_t count;
+
+    Slot* slot(std::size_t i) {
+        return &slabs[i >> SlabBits][i & (kSlabSize - 1)];
+    }
+};
+
+// Bump-арена поверх одного непрерывного std::vector.
+// Самая плотная раскладка, но при росте без reserve узлы переезжают.
+template <typename NodeT>
+class VectorArena {
+public:
+    using value_type = NodeT;
+
+    template <typename... Args>
+    NodeIndex allocate(Args&&... args) {
+        if (nodes.size() >= NIL) {
+            throw std::length_error("VectorArena: node count exceeds 32-bit index");
+        }
+        nodes.emplace_back(std::forward<Args>(args)...);
+        return static_cast<NodeIndex>(nodes.size() - 1);
+    }
+
+    NodeT& operator[](NodeIndex i) { return nodes[i]; }
+    const NodeT& operator[](NodeIndex i) const { return nodes[i]; }
+
+    std::size_t size() const { return nodes.size(); }
+    void reserve(std::size_t n) { nodes.reserve(n); }
+    void clear() { nodes.clear(); }
+
+private:
+    std::vector<NodeT> nodes;
+};
+
+#endif
@@ -0,0 +1,308 @@
+#ifndef STATIC_SEARCH_INDEX_H
+#define STATIC_SEARCH_INDEX_H
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define STATIC_INDEX_HAS_X86 1
+#endif
+
+// Аллокатор с выравниванием по кэш-линии: блоки индекса не должны пересекать линии
+template <typename T>
+struct CacheAlignedAllocator {
+    using value_type = T;
+    static constexpr std::size_t kAlignment = 64;
+
+    CacheAlignedAllocator() = default;
+    template <typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(kAlignment)));
+    }
+
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t(kAlignment));
+    }
+
+    template <typename U>
+    bool operator==(const CacheAlignedAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CacheAlignedAllocator<U>&) const { return false; }
+};
+
+// Статический индекс в раскладке Эйтцингера: корень в a[1], дети k - в 2k и 2k+1.
+// Спуск без ветвлений, потомки на несколько уровней вперед подгружаются заранее:
+// столько уровней, сколько их потомков помещается в кэш-линию (для 4-байтных
+// ключей - 4 уровня, 16 потомков)
+template <typename T>
+class EytzingerIndex {
+public:
+    // Итератор в порядке возрастания ключей
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterator(const EytzingerIndex* index, std::size_t k) : index(index), k(k) {}
+
+        // Следующий по величине: вправо и до упора влево, иначе вверх,
+        // пока идем из правого ребенка (снимаем хвост единиц и еще один бит)
+        Iterator& operator++() {
+            if (2 * k + 1 <= index->n) {
+                k = 2 * k + 1;
+                while (2 * k <= index->n) {
+                    k = 2 * k;
+                }
+            } else {
+                k >>= __builtin_ffsll(~static_cast<long long>(k));
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        const T& operator*() const { return index->keys[k]; }
+        const T* operator->() const { return &index->keys[k]; }
+
+        bool operator==(const Iterator& other) const { return k == other.k; }
+        bool operator!=(const Iterator& other) const { return k != other.k; }
+
+    private:
+        const EytzingerIndex* index;
+        std::size_t k; // 0 - конец
+    };
+
+    // Полуинтервал итераторов для range-based for
+    struct Range {
+        Iterator first;
+        Iterator last;
+        Iterator begin() const { return first; }
+        Iterator end() const { return last; }
+    };
+
+    EytzingerIndex() : n(0), keys(1) {}
+
+    // Из отсортированной последовательности, например обхода BinarySearchTree
+    template <typename InputIt>
+    EytzingerIndex(InputIt first, InputIt last) {
+        std::vector<T> sorted(first, last);
+        init(sorted);
+    }
+
+    explicit EytzingerIndex(const std::vector<T>& sorted) { init(sorted); }
+
+    std::size_t size() const { return n; }
+
+    Iterator begin() const {
+        std::size_t k = n == 0 ? 0 : 1;
+        while (2 * k <= n && k != 0) {
+            k = 2 * k;
+        }
+        return Iterator(this, k);
+    }
+
+    Iterator end() const { return Iterator(this, 0); }
+
+    // Первый ключ >= x
+    Iterator lower_bound(const T& x) const {
+        constexpr std::size_t stride = prefetchStride();
+        const T* base = keys.data();
+        std::size_t k = 1;
+        while (k <= n) {
+            // Prefetch не вызывает ошибок даже за пределами массива
+            __builtin_prefetch(base + k * stride);
+            k = 2 * k + (base[k] < x);
+        }
+        k >>= __builtin_ffsll(~static_cast<long long>(k));
+        return Iterator(this, k);
+    }
+
+    Iterator find(const T& x) const {
+        Iterator it = lower_bound(x);
+        return (it != end() && !(x < *it)) ? it : end();
+    }
+
+    // Все ключи из [lo, hi)
+    Range range(const T& lo, const T& hi) const {
+        return Range{lower_bound(lo), lower_bound(hi)};
+    }
+
+private:
+    std::size_t n;
+    std::vector<T, CacheAlignedAllocator<T>> keys; // keys[0] не используется
+
+    // Потомки k на d уровней ниже - подряд, с k * 2^d: берем наибольшее 2^d,
+    // которое вместе с ключами типа T не длиннее кэш-линии
+    static constexpr std::size_t prefetchStride() {
+        std::size_t stride = 1;
+        while (2 * stride * sizeof(T) <= CacheAlignedAllocator<T>::kAlignment) {
+            stride *= 2;
+        }
+        return stride;
+    }
+
+    void init(const std::vector<T>& sorted) {
+        for (std::size_t i = 1; i < sorted.size(); i++) {
+            if (sorted[i] < sorted[i - 1]) {
+                throw std::invalid_argument("EytzingerIndex: keys are not sorted");
+            }
+        }
+        n = sorted.size();
+        keys.assign(n + 1, T());
+        std::size_t next = 0;
+        place(sorted, next, 1);
+    }
+
+    // In-order обход неявного дерева раскладывает отсортированные ключи по местам
+    void place(const std::vector<T>& sorted, std::size_t& next, std::size_t k) {
+        if (k <= n) {
+            place(sorted, next, 2 * k);
+            keys[k] = sorted[next++];
+            place(sorted, next, 2 * k + 1);
+        }
+    }
+};
+
+// Статическое B-дерево (S-tree) для int: в узле 16 ключей = одна кэш-линия.
+// Позиция внутри узла ищется одним SIMD-сравнением всего блока
+class STreeIndex {
+public:
+    static constexpr int B = CacheAlignedAllocator<int>::kAlignment / sizeof(int);
+    // rankSimd сравнивает блок двумя регистрами по 8 int32
+    static_assert(sizeof(int) == 4 && B == 16, "STreeIndex: AVX2 path expects 16 4-byte keys per block");
+
+    STreeIndex() : n(0), blocks(0) {}
+
+    template <typename InputIt>
+    STreeIndex(InputIt first, InputIt last) {
+        std::vector<int> values(first, last);
+        init(values);
+    }
+
+    explicit STreeIndex(const std::vector<int>& values) { init(values); }
+
+    std::size_t size() const { return n; }
+
+    // Итераторы - по отсортированной копии ключей
+    std::vector<int>::const_iterator begin() const { return sorted.begin(); }
+    std::vector<int>::const_iterator end() const { return sorted.end(); }
+
+    // Первый ключ >= x
+    std::vector<int>::const_iterator lower_bound(int x) const {
+        std::size_t result = n;
+        std::size_t k = 0;
+        while (k < blocks) {
+            const int* block = &keys[k * B];
+            int i = useSimd ? rankSimd(block, x) : rankScalar(block, x);
+            if (i < B) {
+                result = ranks[k * B + i];
+            }
+            k = k * (B + 1) + i + 1;
+        }
+        return sorted.begin() + result;
+    }
+
+    std::vector<int>::const_iterator find(int x) const {
+        auto it = lower_bound(x);
+        return (it != end() && *it == x) ? it : end();
+    }
+
+    // Ключи из [lo, hi) как пара итераторов
+    std::pair<std::vector<int>::const_iterator, std::vector<int>::const_iterator>
+    range(int lo, int hi) const {
+        return {lower_bound(lo), lower_bound(hi)};
+    }
+
+    // SIMD-вариант выключается, например, чтобы сравнить со скалярным
+    void setSimd(bool enabled) { useSimd = enabled && simdSupported(); }
+
+    static bool simdSupported() {
+#ifdef STATIC_INDEX_HAS_X86
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+private:
+    std::size_t n;
+    std::size_t blocks;
+    std::vector<int> sorted;
+    std::vector<int, CacheAlignedAllocator<int>> keys;
+    std::vector<std::uint32_t> ranks; // Позиция ключа блока в sorted
+    bool useSimd = false;
+
+    void init(const std::vector<int>& values) {
+        for (std::size_t i = 1; i < values.size(); i++) {
+            if (values[i] < values[i - 1]) {
+                throw std::invalid_argument("STreeIndex: keys are not sorted");
+            }
+        }
+        sorted = values;
+        n = sorted.size();
+        blocks = (n + B - 1) / B;
+        keys.assign(blocks * B, INT_MAX);
+        ranks.assign(blocks * B, static_cast<std::uint32_t>(n));
+        std::size_t next = 0;
+        place(next, 0);
+        useSimd = simdSupported();
+    }
+
+    // In-order обход: ребенок i блока k - это блок k * (B + 1) + i + 1
+    void place(std::size_t& next, std::size_t k) {
+        if (k >= blocks) {
+            return;
+        }
+        for (int i = 0; i < B; i++) {
+            place(next, k * (B + 1) + i + 1);
+            if (next < n) {
+                keys[k * B + i] = sorted[next];
+                ranks[k * B + i] = static_cast<std::uint32_t>(next);
+                next++;
+            }
+        }
+        place(next, k * (B + 1) + B + 1);
+    }
+
+    // Сколько ключей блока меньше x
+    static int rankScalar(const int* block, int x) {
+        int count = 0;
+        for (int i = 0; i < B; i++) {
+            count += block[i] < x;
+        }
+        return count;
+    }
+
+#ifdef STATIC_INDEX_HAS_X86
+    __attribute__((target("avx2,popcnt")))
+    static int rankSimd(const int* block, int x) {
+        __m256i needle = _mm256_set1_epi32(x);
+        __m256i lo = _mm256_load_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i hi = _mm256_load_si256(reinterpret_cast<const __m256i*>(block + 8));
+        unsigned maskLo = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, lo)));
+        unsigned maskHi = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, hi)));
+        return __builtin_popcount(maskLo | (maskHi << 8));
+    }
+#else
+    static int rankSimd(const int* block, int x) { return rankScalar(block, x); }
+#endif
+};
+
+#endif